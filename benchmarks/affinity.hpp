@@ -0,0 +1,169 @@
+/**
+ * @file affinity.hpp
+ * @brief Thread pinning and CPU topology discovery for the benchmark suite
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * Where a CPU sits in the machine, as reported by sysfs
+ *
+ * l3_id identifies the last-level cache domain: a CCX on AMD EPYC/Ryzen, the
+ * whole socket (or sub-NUMA cluster) on most Intel parts.
+ */
+struct CpuInfo {
+    int cpu = -1;
+    int core_id = -1;
+    int package_id = -1;
+    int l3_id = -1;
+};
+
+/// A producer/consumer CPU pair representing one placement class
+struct CpuPair {
+    std::string label;
+    int producer_cpu;
+    int consumer_cpu;
+};
+
+/// CPUs the benchmark threads are pinned to; -1 leaves placement to the scheduler
+struct ThreadPlacement {
+    int producer_cpu = -1;
+    int consumer_cpu = -1;
+};
+
+/**
+ * Pin the calling thread to a single CPU
+ *
+ * @return true on success; false if cpu is negative, pinning failed, or the
+ *         platform has no affinity support
+ */
+inline bool pinCurrentThread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+namespace topology_detail {
+
+inline int readSysfsInt(const std::string& path) {
+    std::ifstream file(path);
+    int value = -1;
+    if (!(file >> value)) {
+        return -1;
+    }
+    return value;
+}
+
+/// Find the id of the level-3 cache shared by this CPU, or -1
+inline int readL3Id(int cpu) {
+    const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/index";
+    for (int index = 0; index < 8; ++index) {
+        const std::string dir = base + std::to_string(index);
+        if (readSysfsInt(dir + "/level") == 3) {
+            return readSysfsInt(dir + "/id");
+        }
+    }
+    return -1;
+}
+
+} // namespace topology_detail
+
+/**
+ * Read the topology of every CPU this process is allowed to run on
+ *
+ * Returns an empty list where sysfs is unavailable (non-Linux platforms).
+ */
+inline std::vector<CpuInfo> readCpuTopology() {
+    std::vector<CpuInfo> cpus;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        CpuInfo info;
+        info.cpu = cpu;
+        info.core_id = topology_detail::readSysfsInt(base + "core_id");
+        info.package_id = topology_detail::readSysfsInt(base + "physical_package_id");
+        info.l3_id = topology_detail::readL3Id(cpu);
+        if (info.core_id >= 0 && info.package_id >= 0) {
+            cpus.push_back(info);
+        }
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * Pick one representative CPU pair for each placement class present
+ *
+ * Classes, from closest to farthest:
+ *   same-smt      two hyperthreads of one physical core
+ *   same-l3       different cores sharing an L3 (same CCX on AMD)
+ *   cross-l3      same socket, different L3 (cross-CCX on AMD)
+ *   cross-socket  different packages
+ *
+ * Classes the machine does not have (e.g. SMT disabled, single socket) are
+ * left out.
+ */
+inline std::vector<CpuPair> findPlacementPairs(const std::vector<CpuInfo>& cpus) {
+    enum Class { kSameSmt, kSameL3, kCrossL3, kCrossSocket, kClassCount };
+    static const char* const kLabels[kClassCount] = {"same-smt", "same-l3", "cross-l3", "cross-socket"};
+
+    const CpuInfo* found[kClassCount][2] = {};
+    for (const CpuInfo& a : cpus) {
+        for (const CpuInfo& b : cpus) {
+            if (a.cpu >= b.cpu) {
+                continue;
+            }
+            int cls;
+            if (a.package_id != b.package_id) {
+                cls = kCrossSocket;
+            } else if (a.core_id == b.core_id) {
+                cls = kSameSmt;
+            } else if (a.l3_id >= 0 && a.l3_id == b.l3_id) {
+                cls = kSameL3;
+            } else if (a.l3_id >= 0 && b.l3_id >= 0) {
+                cls = kCrossL3;
+            } else {
+                continue;
+            }
+            if (!found[cls][0]) {
+                found[cls][0] = &a;
+                found[cls][1] = &b;
+            }
+        }
+    }
+
+    std::vector<CpuPair> pairs;
+    for (int cls = 0; cls < kClassCount; ++cls) {
+        if (found[cls][0]) {
+            pairs.push_back({kLabels[cls], found[cls][0]->cpu, found[cls][1]->cpu});
+        }
+    }
+    return pairs;
+}
@@ -4,7 +4,19 @@
  * @author Fadli Arsani <fadlialim0029@gmail.com>
  */
 
+#include <lockfree/broadcast_ring_buffer.hpp>
+#include <lockfree/lazy_consumer.hpp>
+#include <lockfree/object_pool_ring.hpp>
 #include <lockfree/ring_buffer.hpp>
+#include <lockfree/ring_set.hpp>
+#include <lockfree/sequenced_ring_buffer.hpp>
+#include <lockfree/write_combining_producer.hpp>
+#include "affinity.hpp"
+#include "latency_histogram.hpp"
+#include "perf_counters.hpp"
+#include <cstdlib>
+#include <array>
+#include <memory>
 #include <iostream>
 #include <iomanip>
 #include <thread>
@@ -14,29 +26,103 @@
 #include <queue>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <utility>
 
 using namespace lockfree;
 
+/// CPUs for the producer/consumer threads of every benchmark (--producer-cpu, --consumer-cpu)
+ThreadPlacement g_placement;
+
+void pinProducer() {
+    if (g_placement.producer_cpu >= 0 && !pinCurrentThread(g_placement.producer_cpu)) {
+        std::cerr << "warning: could not pin producer to CPU " << g_placement.producer_cpu << std::endl;
+    }
+}
+
+void pinConsumer() {
+    if (g_placement.consumer_cpu >= 0 && !pinCurrentThread(g_placement.consumer_cpu)) {
+        std::cerr << "warning: could not pin consumer to CPU " << g_placement.consumer_cpu << std::endl;
+    }
+}
+
+/// Hardware counters for every timed run (--perf); closed unless requested
+PerfCounters g_perf;
+
+/// Counters of the most recent BenchmarkTimer reading
+PerfRun g_last_perf_run;
+
+/**
+ * Wall-clock timer for one run. With --perf it also snapshots the hardware
+ * counters, and each elapsed reading stores the deltas in g_last_perf_run;
+ * read it after joining the run's threads so their counts are included.
+ */
 class BenchmarkTimer {
 private:
     std::chrono::high_resolution_clock::time_point start_;
+    std::vector<double> perf_start_;
+    
+    void recordPerf(double elapsed_ms) const {
+        if (!g_perf.isOpen()) {
+            return;
+        }
+        PerfRun run;
+        run.counts = g_perf.read();
+        for (size_t i = 0; i < run.counts.size() && i < perf_start_.size(); ++i) {
+            run.counts[i] -= perf_start_[i];
+        }
+        run.elapsed_ms = elapsed_ms;
+        g_last_perf_run = run;
+    }
     
 public:
-    BenchmarkTimer() : start_(std::chrono::high_resolution_clock::now()) {}
+    BenchmarkTimer() : perf_start_(g_perf.read()) {
+        start_ = std::chrono::high_resolution_clock::now();
+    }
     
     double elapsedMs() const {
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
+        recordPerf(duration.count() / 1000.0);
         return duration.count() / 1000.0;
     }
     
     double elapsedUs() const {
         auto end = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_);
+        recordPerf(duration.count() / 1000000.0);
         return duration.count() / 1000.0;
     }
 };
 
+/**
+ * Store value where the compiler must assume it is read, so the work that
+ * produced it (a consumer's checksum, a capture it wrote) is not optimized
+ * away. Call it once per run, after the timed loop.
+ */
+template <typename T>
+void doNotOptimize(T value) {
+    static volatile T sink;
+    sink = value;
+}
+
+/// Counters of run per operation, prefixed for appending to a table row; empty without --perf
+std::string perfColumns(double operations, const PerfRun& run = g_last_perf_run) {
+    if (!g_perf.isOpen()) {
+        return "";
+    }
+    return "  " + formatPerfRun(g_perf.names(), run, operations);
+}
+
+/// Print the counters of run per operation on their own line; nothing without --perf
+void printPerf(const std::string& label, double operations, const PerfRun& run = g_last_perf_run) {
+    if (!g_perf.isOpen()) {
+        return;
+    }
+    std::cout << "  " << std::left << std::setw(23) << label << ": "
+              << formatPerfRun(g_perf.names(), run, operations) << std::endl;
+}
+
 void printSeparator(const std::string& title) {
     std::cout << "\n" << std::string(100, '=') << std::endl;
     std::cout << "  " << title << std::endl;
@@ -53,13 +139,17 @@ void printResults(const std::string& test_name, double elapsed_ms, uint64_t oper
     std::cout << std::setw(10) << std::fixed << std::setprecision(2) << elapsed_ms << " ms" << std::endl;
 }
 
+/// Traits that reload the opposite index on every operation (pre-caching behaviour)
+struct UncachedIndexTraits : RingBufferTraits {
+    static constexpr bool kCacheIndices = false;
+};
+
 /**
- * Benchmark 1: Maximum Throughput Test
+ * Run one producer/consumer throughput pass and return combined ops/sec
  */
-void benchmarkMaxThroughput() {
-    printSeparator("Maximum Throughput Benchmark");
-    
-    RingBuffer<uint64_t, 4096> buffer;
+template <typename Buffer>
+double runMaxThroughput(const std::string& label, bool verbose = true) {
+    Buffer buffer;
     constexpr auto TEST_DURATION = std::chrono::seconds(2);
     
     std::atomic<bool> running{true};
@@ -71,6 +161,7 @@ void benchmarkMaxThroughput() {
     
     // Producer thread
     std::thread producer([&]() {
+        pinProducer();
         uint64_t counter = 0;
         while (running.load(std::memory_order_relaxed)) {
             if (buffer.try_push(counter)) {
@@ -85,6 +176,7 @@ void benchmarkMaxThroughput() {
     
     // Consumer thread
     std::thread consumer([&]() {
+        pinConsumer();
         while (running.load(std::memory_order_relaxed)) {
             if (auto item = buffer.try_pop()) {
                 popped.fetch_add(1, std::memory_order_relaxed);
@@ -111,6 +203,11 @@ void benchmarkMaxThroughput() {
     uint64_t total_popped = popped.load();
     uint64_t failures = push_failures.load();
     
+    if (!verbose) {
+        return ((total_pushed + total_popped) * 1000.0) / elapsed_ms;
+    }
+    
+    std::cout << "\n" << label << ":" << std::endl;
     std::cout << "Test Duration    : " << std::fixed << std::setprecision(1) << elapsed_ms << " ms" << std::endl;
     std::cout << "Items Pushed     : " << total_pushed << std::endl;
     std::cout << "Items Popped     : " << total_popped << std::endl;
@@ -121,6 +218,141 @@ void benchmarkMaxThroughput() {
     printResults("Push Throughput", elapsed_ms, total_pushed);
     printResults("Pop Throughput", elapsed_ms, total_popped);
     printResults("Combined Throughput", elapsed_ms, total_pushed + total_popped);
+    printPerf("Counters per op", static_cast<double>(total_pushed + total_popped));
+    
+    return ((total_pushed + total_popped) * 1000.0) / elapsed_ms;
+}
+
+/**
+ * Benchmark 1: Maximum Throughput Test (uncached vs cached indices)
+ */
+void benchmarkMaxThroughput() {
+    printSeparator("Maximum Throughput Benchmark");
+    
+    double uncached = runMaxThroughput<RingBuffer<uint64_t, 4096, UncachedIndexTraits>>(
+        "Uncached indices (reload head_/tail_ every op)");
+    double cached = runMaxThroughput<RingBuffer<uint64_t, 4096>>(
+        "Cached indices (default)");
+    
+    std::cout << "\nIndex caching speedup: " << std::fixed << std::setprecision(2)
+              << (cached / uncached) << "x" << std::endl;
+}
+
+/// Traits giving every slot its own cache line
+struct PaddedSlotTraits : RingBufferTraits {
+    using Layout = PaddedLayout;
+};
+
+/// Traits spreading consecutive positions over different cache lines
+struct ScrambledSlotTraits : RingBufferTraits {
+    using Layout = ScrambledLayout;
+};
+
+/**
+ * Benchmark 1b: Slot layouts (slot false sharing with small elements)
+ */
+void benchmarkSlotLayouts() {
+    printSeparator("Slot Layout Comparison (uint64_t, 4096 slots)");
+
+    double contiguous = runMaxThroughput<RingBuffer<uint64_t, 4096>>("", false);
+    const PerfRun contiguous_perf = g_last_perf_run;
+    double padded = runMaxThroughput<RingBuffer<uint64_t, 4096, PaddedSlotTraits>>("", false);
+    const PerfRun padded_perf = g_last_perf_run;
+    double scrambled = runMaxThroughput<RingBuffer<uint64_t, 4096, ScrambledSlotTraits>>("", false);
+    const PerfRun scrambled_perf = g_last_perf_run;
+
+    std::cout << std::left << std::setw(20) << "Layout" << std::setw(20) << "Ops/sec" << "vs contiguous" << std::endl;
+    std::cout << std::string(55, '-') << std::endl;
+    const std::tuple<const char*, double, const PerfRun&> rows[] = {
+        {"Contiguous", contiguous, contiguous_perf},
+        {"Padded", padded, padded_perf},
+        {"Scrambled", scrambled, scrambled_perf},
+    };
+    for (const auto& [name, ops, perf] : rows) {
+        std::cout << std::left << std::setw(20) << name
+                  << std::setw(20) << std::fixed << std::setprecision(0) << ops
+                  << std::setprecision(2) << (ops / contiguous) << "x"
+                  << perfColumns(ops * perf.elapsed_ms / 1000.0, perf) << std::endl;
+    }
+}
+
+constexpr int BATCHED_INDEX_ITEMS = 20000000;
+
+/**
+ * Move single elements through a ring, publishing the tail every
+ * producer_batch pushes (WriteCombiningProducer) and the head every
+ * consumer_batch pops (LazyConsumer); 0 uses plain try_push/try_pop.
+ * Returns combined ops/sec.
+ */
+double runBatchedIndices(size_t producer_batch, size_t consumer_batch) {
+    using Buffer = RingBuffer<uint64_t, 4096>;
+    auto buffer = std::make_unique<Buffer>();
+    BenchmarkTimer timer;
+
+    std::thread producer([&]() {
+        pinProducer();
+        if (producer_batch == 0) {
+            for (uint64_t i = 0; i < BATCHED_INDEX_ITEMS; ++i) {
+                while (!buffer->try_push(i)) std::this_thread::yield();
+            }
+            return;
+        }
+        WriteCombiningProducer<Buffer> combining(*buffer, producer_batch);
+        for (uint64_t i = 0; i < BATCHED_INDEX_ITEMS; ++i) {
+            while (!combining.try_push(i)) std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&]() {
+        pinConsumer();
+        auto drain = [](auto pop) {
+            uint64_t checksum = 0;
+            for (int received = 0; received < BATCHED_INDEX_ITEMS;) {
+                if (auto item = pop()) {
+                    checksum += *item;
+                    ++received;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            doNotOptimize(checksum);
+        };
+        if (consumer_batch == 0) {
+            drain([&] { return buffer->try_pop(); });
+        } else {
+            LazyConsumer<Buffer> lazy(*buffer, consumer_batch);
+            drain([&] { return lazy.try_pop(); });
+        }
+    });
+    producer.join(); consumer.join();
+
+    double elapsed_ms = timer.elapsedMs();
+    return (BATCHED_INDEX_ITEMS * 2 * 1000.0) / elapsed_ms;
+}
+
+/**
+ * Benchmark 1c: Batched index publication (WriteCombiningProducer, LazyConsumer)
+ */
+void benchmarkBatchedIndices() {
+    printSeparator("Batched Index Publication (uint64_t, 4096 slots, single-element operations)");
+
+    std::cout << std::left << std::setw(20) << "Tail every" << std::setw(20) << "Head every"
+              << std::setw(20) << "Ops/sec" << "vs unbatched" << std::endl;
+    std::cout << std::string(75, '-') << std::endl;
+    const double plain = runBatchedIndices(0, 0);
+    const PerfRun plain_perf = g_last_perf_run;
+    for (const auto& [producer_batch, consumer_batch] :
+         {std::pair<size_t, size_t>{0, 0}, {8, 0}, {32, 0}, {128, 0}, {0, 8}, {0, 32}, {0, 128}, {32, 32}}) {
+        const double ops = producer_batch == 0 && consumer_batch == 0
+                               ? plain
+                               : runBatchedIndices(producer_batch, consumer_batch);
+        std::cout << std::left << std::setw(20) << (producer_batch == 0 ? 1 : producer_batch)
+                  << std::setw(20) << (consumer_batch == 0 ? 1 : consumer_batch)
+                  << std::setw(20) << std::fixed << std::setprecision(0) << ops
+                  << std::setprecision(2) << (ops / plain) << "x"
+                  << perfColumns(BATCHED_INDEX_ITEMS * 2.0,
+                                 producer_batch == 0 && consumer_batch == 0 ? plain_perf : g_last_perf_run)
+                  << std::endl;
+    }
 }
 
 /**
@@ -160,6 +392,186 @@ void benchmarkLatency() {
               << ((push_elapsed + pop_elapsed) / NUM_SAMPLES) << " ns/op" << std::endl;
 }
 
+/// Element carrying the producer's timestamp, padded to the payload size
+template <size_t Size>
+struct TimestampedPayload {
+    static_assert(Size >= sizeof(uint64_t), "payload must hold the timestamp");
+    uint64_t stamp;
+    std::array<unsigned char, Size - sizeof(uint64_t)> padding;
+};
+
+struct LatencyResult {
+    LatencyHistogram one_way;
+    LatencyHistogram round_trip;
+};
+
+constexpr int LATENCY_SAMPLES = 100000;
+constexpr int LATENCY_WARMUP = 10000;
+constexpr auto LATENCY_SEND_INTERVAL = std::chrono::microseconds(2);
+
+/**
+ * One-way latency: the producer stamps each element and pushes it at a fixed
+ * rate well below saturation, the consumer records now - stamp on arrival.
+ * Pacing keeps the buffer nearly empty, so this is handoff latency rather
+ * than queueing delay.
+ */
+template <size_t Capacity, size_t PayloadSize>
+void runOneWayLatency(const CycleClock& clock, LatencyHistogram& histogram) {
+    using Payload = TimestampedPayload<PayloadSize>;
+    auto buffer = std::make_unique<RingBuffer<Payload, Capacity>>();  // large rows exceed the stack
+    const uint64_t interval = clock.ticksFor(LATENCY_SEND_INTERVAL);
+    
+    std::thread consumer([&]() {
+        pinConsumer();
+        for (int i = 0; i < LATENCY_WARMUP + LATENCY_SAMPLES; ++i) {
+            Payload item = buffer->pop();
+            const uint64_t now = CycleClock::now();
+            if (i >= LATENCY_WARMUP) {
+                histogram.record(clock.toNs(item.stamp, now));
+            }
+        }
+    });
+    
+    std::thread producer([&]() {
+        pinProducer();
+        Payload item{};
+        uint64_t next_send = CycleClock::now();
+        for (int i = 0; i < LATENCY_WARMUP + LATENCY_SAMPLES; ++i) {
+            while (CycleClock::now() < next_send) {
+                std::this_thread::yield();
+            }
+            item.stamp = CycleClock::now();
+            buffer->push(item);
+            next_send = item.stamp + interval;
+        }
+    });
+    
+    producer.join();
+    consumer.join();
+}
+
+/**
+ * Round-trip latency: a ping buffer and a pong buffer with exactly one
+ * element in flight. The echo thread bounces every element straight back
+ * and the initiator records the full round trip on its own clock.
+ */
+template <size_t Capacity, size_t PayloadSize>
+void runRoundTripLatency(const CycleClock& clock, LatencyHistogram& histogram) {
+    using Payload = TimestampedPayload<PayloadSize>;
+    auto ping = std::make_unique<RingBuffer<Payload, Capacity>>();
+    auto pong = std::make_unique<RingBuffer<Payload, Capacity>>();
+    
+    std::thread echo([&]() {
+        pinConsumer();
+        for (int i = 0; i < LATENCY_WARMUP + LATENCY_SAMPLES; ++i) {
+            pong->push(ping->pop());
+        }
+    });
+    
+    std::thread initiator([&]() {
+        pinProducer();
+        Payload item{};
+        for (int i = 0; i < LATENCY_WARMUP + LATENCY_SAMPLES; ++i) {
+            item.stamp = CycleClock::now();
+            ping->push(item);
+            item = pong->pop();
+            const uint64_t now = CycleClock::now();
+            if (i >= LATENCY_WARMUP) {
+                histogram.record(clock.toNs(item.stamp, now));
+            }
+        }
+    });
+    
+    initiator.join();
+    echo.join();
+}
+
+void printLatencyRow(size_t capacity, size_t payload, const char* mode, const LatencyHistogram& h) {
+    std::cout << std::left << std::setw(10) << capacity
+              << std::setw(10) << payload
+              << std::setw(10) << mode << std::right
+              << std::setw(10) << h.percentile(50.0)
+              << std::setw(10) << h.percentile(99.0)
+              << std::setw(10) << h.percentile(99.9)
+              << std::setw(12) << h.max() << std::endl;
+}
+
+template <size_t Capacity, size_t PayloadSize>
+void runLatencyDistribution(const CycleClock& clock) {
+    LatencyResult result;
+    runOneWayLatency<Capacity, PayloadSize>(clock, result.one_way);
+    runRoundTripLatency<Capacity, PayloadSize>(clock, result.round_trip);
+    printLatencyRow(Capacity, PayloadSize, "one-way", result.one_way);
+    printLatencyRow(Capacity, PayloadSize, "rtt", result.round_trip);
+}
+
+/**
+ * Benchmark 2b: Cross-Thread Latency Distribution
+ */
+void benchmarkLatencyDistribution() {
+    printSeparator("Latency Distribution (Cross-Thread, ns)");
+    
+    CycleClock clock;
+    std::cout << "Clock: " << CycleClock::name() << ", " << LATENCY_SAMPLES
+              << " samples per row, one-way sends every "
+              << LATENCY_SEND_INTERVAL.count() << " us" << std::endl << std::endl;
+    std::cout << std::left << std::setw(10) << "Capacity"
+              << std::setw(10) << "Payload"
+              << std::setw(10) << "Mode" << std::right
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9"
+              << std::setw(12) << "max" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    
+    runLatencyDistribution<64, 8>(clock);
+    runLatencyDistribution<64, 64>(clock);
+    runLatencyDistribution<64, 256>(clock);
+    runLatencyDistribution<1024, 8>(clock);
+    runLatencyDistribution<1024, 64>(clock);
+    runLatencyDistribution<1024, 256>(clock);
+    runLatencyDistribution<16384, 8>(clock);
+    runLatencyDistribution<16384, 64>(clock);
+    runLatencyDistribution<16384, 256>(clock);
+}
+
+/**
+ * Time NUM_OPERATIONS items through a RingBuffer of the given capacity
+ */
+template <size_t Capacity>
+double runBufferSize(int num_operations) {
+    RingBuffer<int, Capacity> buffer;
+    BenchmarkTimer timer;
+    
+    std::thread producer([&]() {
+        pinProducer();
+        for (int i = 0; i < num_operations; ++i) {
+            while (!buffer.try_push(i)) std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&]() {
+        pinConsumer();
+        for (int i = 0; i < num_operations; ++i) {
+            while (!buffer.try_pop()) std::this_thread::yield();
+        }
+    });
+    producer.join(); consumer.join();
+    
+    return timer.elapsedMs();
+}
+
+template <size_t Capacity>
+void printBufferSize(int num_operations) {
+    double elapsed_ms = runBufferSize<Capacity>(num_operations);
+    double ops_per_sec = (num_operations * 2 * 1000.0) / elapsed_ms; // *2 for push+pop
+    double ns_per_op = (elapsed_ms * 1000000.0) / (num_operations * 2);
+    
+    std::cout << std::left << std::setw(15) << Capacity 
+              << std::setw(15) << std::fixed << std::setprecision(0) << ops_per_sec
+              << std::setw(15) << std::fixed << std::setprecision(2) << ns_per_op
+              << perfColumns(num_operations * 2.0) << std::endl;
+}
+
 /**
  * Benchmark 3: Different Buffer Sizes
  */
@@ -167,91 +579,287 @@ void benchmarkBufferSizes() {
     printSeparator("Buffer Size Comparison");
     
     constexpr int NUM_OPERATIONS = 1000000;
-    std::vector<size_t> sizes = {64, 256, 1024, 4096, 16384};
     
     std::cout << std::left << std::setw(15) << "Buffer Size" 
               << std::setw(15) << "Throughput" 
               << std::setw(15) << "ns/op" << std::endl;
     std::cout << std::string(45, '-') << std::endl;
     
-    for (size_t size : sizes) {
-        BenchmarkTimer timer;
-        
-        if (size == 64) {
-            RingBuffer<int, 64> buffer;
-            std::thread producer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_push(i)) std::this_thread::yield();
-                }
-            });
-            std::thread consumer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_pop()) std::this_thread::yield();
-                }
-            });
-            producer.join(); consumer.join();
-        } else if (size == 256) {
-            RingBuffer<int, 256> buffer;
-            std::thread producer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_push(i)) std::this_thread::yield();
-                }
-            });
-            std::thread consumer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_pop()) std::this_thread::yield();
-                }
-            });
-            producer.join(); consumer.join();
-        } else if (size == 1024) {
-            RingBuffer<int, 1024> buffer;
-            std::thread producer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_push(i)) std::this_thread::yield();
-                }
-            });
-            std::thread consumer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_pop()) std::this_thread::yield();
-                }
-            });
-            producer.join(); consumer.join();
-        } else if (size == 4096) {
-            RingBuffer<int, 4096> buffer;
-            std::thread producer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_push(i)) std::this_thread::yield();
-                }
-            });
-            std::thread consumer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_pop()) std::this_thread::yield();
+    printBufferSize<64>(NUM_OPERATIONS);
+    printBufferSize<256>(NUM_OPERATIONS);
+    printBufferSize<1024>(NUM_OPERATIONS);
+    printBufferSize<4096>(NUM_OPERATIONS);
+    printBufferSize<16384>(NUM_OPERATIONS);
+}
+
+/// Traits prefetching eight slots ahead of both indices
+struct PrefetchTraits : RingBufferTraits {
+    static constexpr size_t kPrefetchDistance = 8;
+};
+
+constexpr size_t PREFETCH_CAPACITY = 65536;  // 4 MB of 64-byte slots, beyond L2
+constexpr int PREFETCH_ITEMS = 2000000;
+
+/**
+ * Stream 64-byte elements through a large ring, the consumer reading each
+ * one; returns combined ops/sec
+ */
+template <typename Traits>
+double runPrefetch(bool batched) {
+    using Payload = TimestampedPayload<64>;
+    auto buffer = std::make_unique<RingBuffer<Payload, PREFETCH_CAPACITY, Traits>>();
+    BenchmarkTimer timer;
+
+    std::thread producer([&]() {
+        pinProducer();
+        Payload payload{};
+        for (int i = 0; i < PREFETCH_ITEMS; ++i) {
+            payload.stamp = static_cast<uint64_t>(i);
+            while (!buffer->try_push(payload)) std::this_thread::yield();
+        }
+    });
+    std::thread consumer([&]() {
+        pinConsumer();
+        Payload batch[32];
+        uint64_t checksum = 0;
+        int received = 0;
+        while (received < PREFETCH_ITEMS) {
+            size_t count = 0;
+            if (batched) {
+                count = buffer->try_pop_n(batch, 32);
+            } else if (auto item = buffer->try_pop()) {
+                batch[0] = *item;
+                count = 1;
+            }
+            if (count == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                checksum += batch[i].stamp + batch[i].padding[0];
+            }
+            received += static_cast<int>(count);
+        }
+        doNotOptimize(checksum);
+    });
+    producer.join(); consumer.join();
+
+    double elapsed_ms = timer.elapsedMs();
+    return (PREFETCH_ITEMS * 2 * 1000.0) / elapsed_ms;
+}
+
+/**
+ * Benchmark 3b: Software prefetch of upcoming slots (kPrefetchDistance)
+ */
+void benchmarkPrefetch() {
+    printSeparator("Slot Prefetch (64-byte elements, 65536 slots)");
+
+    std::cout << std::left << std::setw(15) << "Consumer"
+              << std::setw(20) << "No prefetch"
+              << std::setw(20) << "Distance 8"
+              << std::setw(10) << "Speedup" << std::endl;
+    std::cout << std::string(65, '-') << std::endl;
+
+    for (bool batched : {false, true}) {
+        double plain = runPrefetch<RingBufferTraits>(batched);
+        const PerfRun plain_perf = g_last_perf_run;
+        double prefetched = runPrefetch<PrefetchTraits>(batched);
+        std::cout << std::left << std::setw(15) << (batched ? "try_pop_n(32)" : "try_pop")
+                  << std::setw(20) << std::fixed << std::setprecision(0) << plain
+                  << std::setw(20) << prefetched
+                  << std::setprecision(2) << (prefetched / plain) << "x" << std::endl;
+        printPerf("No prefetch", PREFETCH_ITEMS * 2.0, plain_perf);
+        printPerf("Distance 8", PREFETCH_ITEMS * 2.0);
+    }
+}
+
+constexpr size_t BULK_CAPACITY = 65536;
+constexpr size_t BULK_BATCH = 256;
+constexpr size_t BULK_ITEMS = 1u << 23;  // 32 MB of floats, captured in full by the consumer
+
+/// Consumer strategies for moving batches of floats out of the ring
+enum class BulkPop { Copy, CopyThenScale, Transform, Streaming };
+
+/**
+ * Stream floats through a ring into a large capture array, optionally
+ * scaling them on the way; returns combined ops/sec
+ */
+double runBulkPop(BulkPop mode) {
+    auto buffer = std::make_unique<RingBuffer<float, BULK_CAPACITY>>();
+    std::vector<float> capture(BULK_ITEMS);
+    BenchmarkTimer timer;
+
+    std::thread producer([&]() {
+        pinProducer();
+        std::vector<float> batch(BULK_BATCH);
+        for (size_t sent = 0; sent < BULK_ITEMS;) {
+            for (size_t i = 0; i < BULK_BATCH; ++i) {
+                batch[i] = static_cast<float>(sent + i);
+            }
+            size_t pushed = 0;
+            while (pushed < BULK_BATCH) {
+                const size_t n = buffer->try_push_n(batch.data() + pushed, BULK_BATCH - pushed);
+                if (n == 0) std::this_thread::yield();
+                pushed += n;
+            }
+            sent += BULK_BATCH;
+        }
+    });
+    std::thread consumer([&]() {
+        pinConsumer();
+        for (size_t received = 0; received < BULK_ITEMS;) {
+            float* out = capture.data() + received;
+            size_t count = 0;
+            switch (mode) {
+            case BulkPop::Copy:
+                count = buffer->try_pop_n(out, BULK_BATCH);
+                break;
+            case BulkPop::CopyThenScale:
+                count = buffer->try_pop_n(out, BULK_BATCH);
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] *= 0.5f;
                 }
-            });
-            producer.join(); consumer.join();
-        } else if (size == 16384) {
-            RingBuffer<int, 16384> buffer;
-            std::thread producer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_push(i)) std::this_thread::yield();
+                break;
+            case BulkPop::Transform:
+                count = buffer->try_pop_n_transform(out, BULK_BATCH, [](float x) noexcept { return x * 0.5f; });
+                break;
+            case BulkPop::Streaming:
+                count = buffer->try_pop_n_streaming(out, BULK_BATCH);
+                break;
+            }
+            if (count == 0) std::this_thread::yield();
+            received += count;
+        }
+    });
+    producer.join(); consumer.join();
+
+    double elapsed_ms = timer.elapsedMs();
+    doNotOptimize(capture[BULK_ITEMS / 2]);
+    return (BULK_ITEMS * 2 * 1000.0) / elapsed_ms;
+}
+
+/**
+ * Benchmark 3c: Bulk consumer paths (transform-on-pop, streaming stores)
+ */
+void benchmarkBulkPop() {
+    printSeparator("Bulk Pop (float, 65536 slots, 256-element batches, 32 MB capture)");
+
+    std::cout << std::left << std::setw(30) << "Consumer"
+              << std::setw(20) << "Ops/sec" << "vs try_pop_n" << std::endl;
+    std::cout << std::string(60, '-') << std::endl;
+
+    const double plain = runBulkPop(BulkPop::Copy);
+    const PerfRun plain_perf = g_last_perf_run;
+    const std::pair<BulkPop, const char*> modes[] = {
+        {BulkPop::Copy, "try_pop_n"},
+        {BulkPop::Streaming, "try_pop_n_streaming"},
+        {BulkPop::CopyThenScale, "try_pop_n + scale pass"},
+        {BulkPop::Transform, "try_pop_n_transform (scale)"},
+    };
+    for (const auto& [mode, name] : modes) {
+        const double ops = mode == BulkPop::Copy ? plain : runBulkPop(mode);
+        std::cout << std::left << std::setw(30) << name
+                  << std::setw(20) << std::fixed << std::setprecision(0) << ops
+                  << std::setprecision(2) << (ops / plain) << "x"
+                  << perfColumns(BULK_ITEMS * 2.0, mode == BulkPop::Copy ? plain_perf : g_last_perf_run)
+                  << std::endl;
+    }
+}
+
+constexpr int POOL_ITEMS = 2000000;
+constexpr size_t POOL_PAYLOAD = 256;
+
+/// Message owning a heap buffer, as most real payloads do
+struct HeapMessage {
+    uint64_t sequence = 0;
+    std::vector<char> payload;
+};
+
+/**
+ * Send heap-backed messages either by value through a RingBuffer (a
+ * malloc per message on the producer, a free on the consumer) or through an
+ * ObjectPoolRing that recycles them; returns combined ops/sec
+ */
+double runObjectPool(bool pooled) {
+    BenchmarkTimer timer;
+    if (pooled) {
+        auto packets = std::make_unique<ObjectPoolRing<HeapMessage, 1024>>(
+            [](HeapMessage& m) { m.payload.reserve(POOL_PAYLOAD); });
+        std::thread producer([&]() {
+            pinProducer();
+            for (int i = 0; i < POOL_ITEMS; ++i) {
+                HeapMessage* m = nullptr;
+                while ((m = packets->try_acquire()) == nullptr) std::this_thread::yield();
+                m->sequence = static_cast<uint64_t>(i);
+                m->payload.assign(POOL_PAYLOAD, static_cast<char>(i));
+                packets->publish(m);
+            }
+        });
+        std::thread consumer([&]() {
+            pinConsumer();
+            uint64_t checksum = 0;
+            for (int received = 0; received < POOL_ITEMS;) {
+                if (packets->try_consume([&](HeapMessage& m) { checksum += m.sequence + m.payload[0]; })) {
+                    ++received;
+                } else {
+                    std::this_thread::yield();
                 }
-            });
-            std::thread consumer([&]() {
-                for (int i = 0; i < NUM_OPERATIONS; ++i) {
-                    while (!buffer.try_pop()) std::this_thread::yield();
+            }
+            doNotOptimize(checksum);
+        });
+        producer.join(); consumer.join();
+    } else {
+        auto ring = std::make_unique<RingBuffer<HeapMessage, 1024>>();
+        std::thread producer([&]() {
+            pinProducer();
+            for (int i = 0; i < POOL_ITEMS; ++i) {
+                HeapMessage m;
+                m.sequence = static_cast<uint64_t>(i);
+                m.payload.assign(POOL_PAYLOAD, static_cast<char>(i));
+                while (!ring->try_push(std::move(m))) std::this_thread::yield();
+            }
+        });
+        std::thread consumer([&]() {
+            pinConsumer();
+            uint64_t checksum = 0;
+            HeapMessage m;
+            for (int received = 0; received < POOL_ITEMS;) {
+                if (ring->try_pop(m)) {
+                    checksum += m.sequence + m.payload[0];
+                    ++received;
+                } else {
+                    std::this_thread::yield();
                 }
-            });
-            producer.join(); consumer.join();
-        }
-        
-        double elapsed_ms = timer.elapsedMs();
-        double ops_per_sec = (NUM_OPERATIONS * 2 * 1000.0) / elapsed_ms; // *2 for push+pop
-        double ns_per_op = (elapsed_ms * 1000000.0) / (NUM_OPERATIONS * 2);
-        
-        std::cout << std::left << std::setw(15) << size 
-                  << std::setw(15) << std::fixed << std::setprecision(0) << ops_per_sec
-                  << std::setw(15) << std::fixed << std::setprecision(2) << ns_per_op << std::endl;
+            }
+            doNotOptimize(checksum);
+        });
+        producer.join(); consumer.join();
     }
+
+    double elapsed_ms = timer.elapsedMs();
+    return (POOL_ITEMS * 2 * 1000.0) / elapsed_ms;
+}
+
+/**
+ * Benchmark 3d: Recycled message objects (ObjectPoolRing) vs allocating per message
+ */
+void benchmarkObjectPool() {
+    printSeparator("Heap-Backed Messages (256-byte std::vector payload, 1024 slots)");
+
+    std::cout << std::left << std::setw(30) << "Transport"
+              << std::setw(20) << "Ops/sec" << "vs allocating" << std::endl;
+    std::cout << std::string(63, '-') << std::endl;
+
+    const double allocating = runObjectPool(false);
+    const PerfRun allocating_perf = g_last_perf_run;
+    const double pooled = runObjectPool(true);
+    std::cout << std::left << std::setw(30) << "RingBuffer, new vector each"
+              << std::setw(20) << std::fixed << std::setprecision(0) << allocating
+              << std::setprecision(2) << 1.0 << "x" << perfColumns(POOL_ITEMS * 2.0, allocating_perf) << std::endl;
+    std::cout << std::left << std::setw(30) << "ObjectPoolRing, recycled"
+              << std::setw(20) << std::fixed << std::setprecision(0) << pooled
+              << std::setprecision(2) << (pooled / allocating) << "x" << perfColumns(POOL_ITEMS * 2.0)
+              << std::endl;
 }
 
 /**
@@ -270,6 +878,7 @@ void benchmarkVsStdQueue() {
         BenchmarkTimer timer;
         
         std::thread producer([&]() {
+            pinProducer();
             for (int i = 0; i < NUM_OPERATIONS; ++i) {
                 while (!buffer.try_push(i)) {
                     std::this_thread::yield();
@@ -278,6 +887,7 @@ void benchmarkVsStdQueue() {
         });
         
         std::thread consumer([&]() {
+            pinConsumer();
             for (int i = 0; i < NUM_OPERATIONS; ++i) {
                 while (!buffer.try_pop()) {
                     std::this_thread::yield();
@@ -290,6 +900,7 @@ void benchmarkVsStdQueue() {
         
         ring_time = timer.elapsedMs();
         printResults("SPSC Ring Buffer", ring_time, NUM_OPERATIONS * 2);
+        printPerf("Counters per op", NUM_OPERATIONS * 2.0);
     }
     
     // Test std::queue + mutex
@@ -299,6 +910,7 @@ void benchmarkVsStdQueue() {
         BenchmarkTimer timer;
         
         std::thread producer([&]() {
+            pinProducer();
             for (int i = 0; i < NUM_OPERATIONS; ++i) {
                 std::lock_guard<std::mutex> lock(mutex);
                 queue.push(i);
@@ -306,6 +918,7 @@ void benchmarkVsStdQueue() {
         });
         
         std::thread consumer([&]() {
+            pinConsumer();
             for (int i = 0; i < NUM_OPERATIONS; ++i) {
                 std::unique_lock<std::mutex> lock(mutex);
                 while (queue.empty()) {
@@ -322,6 +935,7 @@ void benchmarkVsStdQueue() {
         
         mutex_time = timer.elapsedMs();
         printResults("std::queue + mutex", mutex_time, NUM_OPERATIONS * 2);
+        printPerf("Counters per op", NUM_OPERATIONS * 2.0);
     }
     
     // Calculate speedup
@@ -330,6 +944,180 @@ void benchmarkVsStdQueue() {
               << speedup << "x faster" << std::endl;
 }
 
+/// Minimal test-and-test-and-set spinlock, the usual way to share a RingBuffer
+class SpinLock {
+    std::atomic<bool> locked_{false};
+    
+public:
+    void lock() {
+        while (locked_.exchange(true, std::memory_order_acquire)) {
+            while (locked_.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    void unlock() { locked_.store(false, std::memory_order_release); }
+};
+
+/// Time num_producers threads funnelling items into one consumer
+template <typename Push, typename Pop>
+double runFanIn(int num_producers, int items_per_producer, Push push, Pop pop) {
+    BenchmarkTimer timer;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&, p]() {
+            for (int i = 0; i < items_per_producer; ++i) {
+                while (!push(p, i)) std::this_thread::yield();
+            }
+        });
+    }
+    std::thread consumer([&]() {
+        pinConsumer();
+        for (int i = 0; i < num_producers * items_per_producer; ++i) {
+            while (!pop()) std::this_thread::yield();
+        }
+    });
+    for (auto& producer : producers) producer.join();
+    consumer.join();
+    return timer.elapsedMs();
+}
+
+/**
+ * Benchmark 4b: MPSC and per-producer rings vs spinlock-wrapped RingBuffer
+ */
+void benchmarkMultiProducer() {
+    printSeparator("MpscRingBuffer / RingSet vs Spinlock + RingBuffer (fan-in)");
+    
+    constexpr int ITEMS_PER_PRODUCER = 200000;
+    
+    std::cout << std::left << std::setw(12) << "Producers"
+              << std::setw(20) << "Spinlock ops/sec"
+              << std::setw(20) << "MPSC ops/sec"
+              << std::setw(20) << "RingSet ops/sec" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+    
+    for (int producers : {1, 2, 4, 8}) {
+        const double total = static_cast<double>(producers) * ITEMS_PER_PRODUCER;
+        
+        auto locked = std::make_unique<RingBuffer<int, 4096>>();
+        SpinLock lock;
+        const double locked_ms = runFanIn(producers, ITEMS_PER_PRODUCER,
+            [&](int, int i) { std::lock_guard<SpinLock> guard(lock); return locked->try_push(i); },
+            [&]() { return locked->try_pop().has_value(); });
+        const PerfRun locked_perf = g_last_perf_run;
+        
+        auto mpsc = std::make_unique<MpscRingBuffer<int, 4096>>();
+        const double mpsc_ms = runFanIn(producers, ITEMS_PER_PRODUCER,
+            [&](int, int i) { return mpsc->try_push(i); },
+            [&]() { return mpsc->try_pop().has_value(); });
+        const PerfRun mpsc_perf = g_last_perf_run;
+        
+        // One 512-slot ring per producer, so the total buffering matches
+        auto set = std::make_unique<RingSet<int, 512, 8>>();
+        std::vector<RingSet<int, 512, 8>::Producer> handles;
+        for (int p = 0; p < producers; ++p) handles.push_back(set->producer(p));
+        const double set_ms = runFanIn(producers, ITEMS_PER_PRODUCER,
+            [&](int p, int i) { return handles[p].try_push(i); },
+            [&]() { return set->try_pop().has_value(); });
+        
+        std::cout << std::left << std::setw(12) << producers
+                  << std::setw(20) << std::fixed << std::setprecision(0) << total * 1000.0 / locked_ms
+                  << std::setw(20) << total * 1000.0 / mpsc_ms
+                  << std::setw(20) << total * 1000.0 / set_ms << std::endl;
+        printPerf("Spinlock", total * 2.0, locked_perf);
+        printPerf("MPSC", total * 2.0, mpsc_perf);
+        printPerf("RingSet", total * 2.0);
+    }
+}
+
+constexpr int FAN_OUT_READERS = 3;
+constexpr int FAN_OUT_ITEMS = 200000;
+
+/// Time one producer delivering every item to FAN_OUT_READERS consumers
+template <typename Publish, typename Consume>
+double runFanOut(Publish publish, Consume consume) {
+    BenchmarkTimer timer;
+    std::vector<std::thread> readers;
+    for (int r = 0; r < FAN_OUT_READERS; ++r) {
+        readers.emplace_back([&, r]() {
+            for (int i = 0; i < FAN_OUT_ITEMS; ++i) {
+                while (!consume(r)) std::this_thread::yield();
+            }
+        });
+    }
+    std::thread producer([&]() {
+        pinProducer();
+        for (int i = 0; i < FAN_OUT_ITEMS; ++i) {
+            publish(static_cast<uint64_t>(i));
+        }
+    });
+    producer.join();
+    for (auto& reader : readers) reader.join();
+    return timer.elapsedMs();
+}
+
+template <size_t PayloadSize>
+void printFanOut() {
+    using Payload = TimestampedPayload<PayloadSize>;
+    
+    // One ring per reader, each item copied into all of them
+    std::array<std::unique_ptr<RingBuffer<Payload, 1024>>, FAN_OUT_READERS> copies;
+    for (auto& ring : copies) ring = std::make_unique<RingBuffer<Payload, 1024>>();
+    const double copy_ms = runFanOut(
+        [&](uint64_t i) {
+            Payload item{};
+            item.stamp = i;
+            for (auto& ring : copies) {
+                while (!ring->try_push(item)) std::this_thread::yield();
+            }
+        },
+        [&](int r) { return copies[r]->try_pop().has_value(); });
+    const PerfRun copy_perf = g_last_perf_run;
+    
+    // One shared ring, each item written once
+    auto broadcast = std::make_unique<BroadcastRingBuffer<Payload, 1024, FAN_OUT_READERS>>();
+    std::vector<typename BroadcastRingBuffer<Payload, 1024, FAN_OUT_READERS>::Reader> readers;
+    for (int r = 0; r < FAN_OUT_READERS; ++r) readers.push_back(broadcast->reader(r));
+    const double broadcast_ms = runFanOut(
+        [&](uint64_t i) {
+            Payload item{};
+            item.stamp = i;
+            while (!broadcast->try_push(item)) std::this_thread::yield();
+        },
+        [&](int r) {
+            if (readers[r].front()) {
+                readers[r].pop_front();
+                return true;
+            }
+            return false;
+        });
+    
+    std::cout << std::left << std::setw(12) << (std::to_string(PayloadSize) + "B")
+              << std::setw(20) << std::fixed << std::setprecision(0) << FAN_OUT_ITEMS * 1000.0 / copy_ms
+              << std::setw(20) << FAN_OUT_ITEMS * 1000.0 / broadcast_ms
+              << std::setprecision(2) << copy_ms / broadcast_ms << "x" << std::endl;
+    // Per message delivered to every reader
+    printPerf("Copies", FAN_OUT_ITEMS, copy_perf);
+    printPerf("Broadcast", FAN_OUT_ITEMS);
+}
+
+/**
+ * Benchmark 4c: BroadcastRingBuffer vs one RingBuffer copy per reader
+ */
+void benchmarkFanOut() {
+    printSeparator("BroadcastRingBuffer vs RingBuffer per Reader (3 readers)");
+    
+    std::cout << std::left << std::setw(12) << "Payload"
+              << std::setw(20) << "Copies msgs/sec"
+              << std::setw(20) << "Broadcast msgs/sec"
+              << std::setw(10) << "Speedup" << std::endl;
+    std::cout << std::string(62, '-') << std::endl;
+    
+    printFanOut<8>();
+    printFanOut<64>();
+    printFanOut<256>();
+}
+
 /**
  * Benchmark 5: Memory Usage Analysis
  */
@@ -357,7 +1145,116 @@ void benchmarkMemoryUsage() {
     }
 }
 
-int main() {
+/**
+ * Benchmark 6: Placement Sweep (--sweep)
+ *
+ * Reruns throughput and latency with the two threads pinned to one CPU pair
+ * per topology class, so results can be compared across SMT siblings, cores
+ * sharing an L3 (CCX), cores on different L3s, and sockets.
+ */
+void benchmarkPlacementSweep() {
+    printSeparator("Placement Sweep (Producer/Consumer CPU Pairs)");
+    
+    const std::vector<CpuPair> pairs = findPlacementPairs(readCpuTopology());
+    if (pairs.empty()) {
+        std::cout << "No CPU pairs available (need at least 2 CPUs and Linux sysfs topology)" << std::endl;
+        return;
+    }
+    
+    CycleClock clock;
+    std::cout << "Throughput: RingBuffer<uint64_t, 4096>; latency: capacity 1024, 64-byte payload (ns)"
+              << std::endl << std::endl;
+    std::cout << std::left << std::setw(14) << "Placement"
+              << std::setw(10) << "CPUs" << std::right
+              << std::setw(14) << "Mops/sec"
+              << std::setw(12) << "1-way p50"
+              << std::setw(12) << "1-way p99"
+              << std::setw(12) << "rtt p50"
+              << std::setw(12) << "rtt p99" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+    
+    const ThreadPlacement saved = g_placement;
+    for (const CpuPair& pair : pairs) {
+        g_placement.producer_cpu = pair.producer_cpu;
+        g_placement.consumer_cpu = pair.consumer_cpu;
+        
+        const double throughput = runMaxThroughput<RingBuffer<uint64_t, 4096>>(pair.label, false);
+        LatencyResult latency;
+        runOneWayLatency<1024, 64>(clock, latency.one_way);
+        runRoundTripLatency<1024, 64>(clock, latency.round_trip);
+        
+        const std::string cpus = std::to_string(pair.producer_cpu) + "," + std::to_string(pair.consumer_cpu);
+        std::cout << std::left << std::setw(14) << pair.label
+                  << std::setw(10) << cpus << std::right
+                  << std::setw(14) << std::fixed << std::setprecision(2) << throughput / 1e6
+                  << std::setw(12) << latency.one_way.percentile(50.0)
+                  << std::setw(12) << latency.one_way.percentile(99.0)
+                  << std::setw(12) << latency.round_trip.percentile(50.0)
+                  << std::setw(12) << latency.round_trip.percentile(99.0) << std::endl;
+    }
+    g_placement = saved;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --producer-cpu N   Pin producer threads to CPU N (env: SPSC_BENCH_PRODUCER_CPU)\n"
+              << "  --consumer-cpu N   Pin consumer threads to CPU N (env: SPSC_BENCH_CONSUMER_CPU)\n"
+              << "  --sweep            Only run the placement sweep across SMT/L3/socket CPU pairs\n"
+              << "  --perf             Print hardware counters per operation (Linux perf_event_open)\n"
+              << "  --perf-hitm HEX    Also count this raw PMU event as HITM, e.g. 0x04d2 on Skylake-SP\n"
+              << "  --help             Show this message" << std::endl;
+}
+
+int parseCpu(const char* value, const char* option) {
+    char* end = nullptr;
+    const long cpu = std::strtol(value, &end, 10);
+    if (end == value || *end != '\0' || cpu < 0) {
+        std::cerr << "Invalid CPU for " << option << ": " << value << std::endl;
+        std::exit(1);
+    }
+    return static_cast<int>(cpu);
+}
+
+int main(int argc, char** argv) {
+    bool sweep = false;
+    bool perf = false;
+    uint64_t hitm_config = 0;
+    
+    if (const char* env = std::getenv("SPSC_BENCH_PRODUCER_CPU")) {
+        g_placement.producer_cpu = parseCpu(env, "SPSC_BENCH_PRODUCER_CPU");
+    }
+    if (const char* env = std::getenv("SPSC_BENCH_CONSUMER_CPU")) {
+        g_placement.consumer_cpu = parseCpu(env, "SPSC_BENCH_CONSUMER_CPU");
+    }
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "--producer-cpu" || arg == "--consumer-cpu") && i + 1 < argc) {
+            int& cpu = arg == "--producer-cpu" ? g_placement.producer_cpu : g_placement.consumer_cpu;
+            cpu = parseCpu(argv[i + 1], argv[i]);
+            ++i;
+        } else if (arg == "--sweep") {
+            sweep = true;
+        } else if (arg == "--perf") {
+            perf = true;
+        } else if (arg == "--perf-hitm" && i + 1 < argc) {
+            char* end = nullptr;
+            hitm_config = std::strtoull(argv[i + 1], &end, 16);
+            if (end == argv[i + 1] || *end != '\0' || hitm_config == 0) {
+                std::cerr << "Invalid raw event for --perf-hitm: " << argv[i + 1] << std::endl;
+                return 1;
+            }
+            perf = true;
+            ++i;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
     std::cout << "SPSC Ring Buffer Benchmark Suite" << std::endl;
     std::cout << "=================================" << std::endl;
 #ifdef __VERSION__
@@ -368,12 +1265,40 @@ int main() {
     std::cout << "Compiler: Unknown" << std::endl;
 #endif
     std::cout << "CPU Cores: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "Placement: producer CPU "
+              << (g_placement.producer_cpu >= 0 ? std::to_string(g_placement.producer_cpu) : "any")
+              << ", consumer CPU "
+              << (g_placement.consumer_cpu >= 0 ? std::to_string(g_placement.consumer_cpu) : "any")
+              << std::endl;
     
-    benchmarkMaxThroughput();
-    benchmarkLatency();
-    benchmarkBufferSizes();
-    benchmarkVsStdQueue();
-    benchmarkMemoryUsage();
+    // Opened before any benchmark thread exists, so every thread inherits them
+    if (perf) {
+        const std::string error = g_perf.open(hitm_config);
+        if (error.empty()) {
+            std::cout << "Counters: user space, per operation (push or pop)" << std::endl;
+        } else {
+            std::cerr << "warning: hardware counters unavailable (" << error
+                      << "); check /proc/sys/kernel/perf_event_paranoid" << std::endl;
+        }
+    }
+    
+    if (sweep) {
+        benchmarkPlacementSweep();
+    } else {
+        benchmarkMaxThroughput();
+        benchmarkSlotLayouts();
+        benchmarkBatchedIndices();
+        benchmarkLatency();
+        benchmarkLatencyDistribution();
+        benchmarkBufferSizes();
+        benchmarkPrefetch();
+        benchmarkBulkPop();
+        benchmarkObjectPool();
+        benchmarkVsStdQueue();
+        benchmarkMultiProducer();
+        benchmarkFanOut();
+        benchmarkMemoryUsage();
+    }
     
     std::cout << "\n" << std::string(100, '=') << std::endl;
     std::cout << "Benchmark Complete!" << std::endl;
@@ -0,0 +1,288 @@
+/**
+ * @file benchmark_gbench.cpp
+ * @brief Parameterized Google Benchmark suite for the SPSC ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * Sweeps capacity x element type x operation, with every benchmark named
+ * BM_<Op><Queue, Capacity, Element>. Run with --benchmark_format=json (or
+ * --benchmark_out=results.json) to record results for regression tracking.
+ *
+ * Other SPSC queues are benchmarked on the same axes when their headers are
+ * on the include path: boost::lockfree::spsc_queue, rigtorp::SPSCQueue and
+ * folly::ProducerConsumerQueue.
+ */
+
+#include <lockfree/ring_buffer.hpp>
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+
+#if __has_include(<boost/lockfree/spsc_queue.hpp>)
+#include <boost/lockfree/spsc_queue.hpp>
+#define SPSC_BENCH_HAVE_BOOST 1
+#endif
+#if __has_include(<rigtorp/SPSCQueue.h>)
+#include <rigtorp/SPSCQueue.h>
+#define SPSC_BENCH_HAVE_RIGTORP 1
+#endif
+#if __has_include(<folly/ProducerConsumerQueue.h>)
+#include <folly/ProducerConsumerQueue.h>
+#define SPSC_BENCH_HAVE_FOLLY 1
+#endif
+
+namespace {
+
+constexpr std::size_t kBatchSize = 32;
+
+/// Trivially copyable element of the given size
+template <std::size_t Size>
+struct Bytes {
+    std::array<unsigned char, Size> data;
+};
+
+/// Element whose copy allocates, to measure the non-memcpy paths
+struct NonTrivial {
+    std::string text;
+};
+
+using Bytes8 = Bytes<8>;
+using Bytes64 = Bytes<64>;
+using Bytes256 = Bytes<256>;
+
+template <typename T>
+T makeElement(std::size_t i) {
+    T element{};
+    element.data[0] = static_cast<unsigned char>(i);
+    return element;
+}
+
+template <>
+NonTrivial makeElement<NonTrivial>(std::size_t i) {
+    // Longer than any small-string buffer, so every copy allocates
+    return NonTrivial{std::string(32, static_cast<char>('a' + i % 26))};
+}
+
+/*
+ * Queue adapters: a uniform try_push/try_pop(T&) surface over each
+ * implementation, constructed with the same capacity.
+ */
+
+template <typename T, std::size_t Capacity>
+struct LockfreeRing {
+    lockfree::RingBuffer<T, Capacity> queue;
+
+    bool try_push(const T& item) { return queue.try_push(item); }
+    bool try_pop(T& item) {
+        if (auto popped = queue.try_pop()) {
+            item = std::move(*popped);
+            return true;
+        }
+        return false;
+    }
+};
+
+#ifdef SPSC_BENCH_HAVE_BOOST
+template <typename T, std::size_t Capacity>
+struct BoostSpsc {
+    boost::lockfree::spsc_queue<T, boost::lockfree::capacity<Capacity>> queue;
+
+    bool try_push(const T& item) { return queue.push(item); }
+    bool try_pop(T& item) { return queue.pop(item); }
+};
+#endif
+
+#ifdef SPSC_BENCH_HAVE_RIGTORP
+template <typename T, std::size_t Capacity>
+struct RigtorpSpsc {
+    rigtorp::SPSCQueue<T> queue{Capacity};
+
+    bool try_push(const T& item) { return queue.try_push(item); }
+    bool try_pop(T& item) {
+        if (T* front = queue.front()) {
+            item = std::move(*front);
+            queue.pop();
+            return true;
+        }
+        return false;
+    }
+};
+#endif
+
+#ifdef SPSC_BENCH_HAVE_FOLLY
+template <typename T, std::size_t Capacity>
+struct FollyPcq {
+    folly::ProducerConsumerQueue<T> queue{Capacity};
+
+    bool try_push(const T& item) { return queue.write(item); }
+    bool try_pop(T& item) { return queue.read(item); }
+};
+#endif
+
+/**
+ * Runs consume(queue) on a background thread until the benchmark loop ends
+ * and the queue is drained. The benchmark thread is the producer and is the
+ * one being timed.
+ */
+class ConsumerThread {
+private:
+    std::atomic<bool> done_{false};
+    std::thread thread_;
+
+public:
+    template <typename Consume>
+    explicit ConsumerThread(Consume consume)
+        : thread_([this, consume]() mutable {
+              while (!done_.load(std::memory_order_acquire)) {
+                  if (!consume()) {
+                      std::this_thread::yield();
+                  }
+              }
+              while (consume()) {
+              }
+          }) {}
+
+    ~ConsumerThread() {
+        done_.store(true, std::memory_order_release);
+        thread_.join();
+    }
+};
+
+void reportItems(benchmark::State& state, std::size_t items, std::size_t element_size) {
+    state.SetItemsProcessed(static_cast<int64_t>(items));
+    state.SetBytesProcessed(static_cast<int64_t>(items * element_size));
+}
+
+/// Single-element try_push/try_pop, on any adapter
+template <template <typename, std::size_t> class Queue, std::size_t Capacity, typename T>
+void BM_Single(benchmark::State& state) {
+    auto queue = std::make_unique<Queue<T, Capacity>>();
+    const T element = makeElement<T>(1);
+    {
+        ConsumerThread consumer([&queue, item = T{}]() mutable {
+            if (!queue->try_pop(item)) {
+                return false;
+            }
+            benchmark::DoNotOptimize(item);
+            return true;
+        });
+        for (auto _ : state) {
+            while (!queue->try_push(element)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    reportItems(state, static_cast<std::size_t>(state.iterations()), sizeof(T));
+}
+
+/// try_push_n/try_pop_n with kBatchSize elements per iteration
+template <std::size_t Capacity, typename T>
+void BM_Batch(benchmark::State& state) {
+    auto buffer = std::make_unique<lockfree::RingBuffer<T, Capacity>>();
+    std::array<T, kBatchSize> batch;
+    for (std::size_t i = 0; i < kBatchSize; ++i) {
+        batch[i] = makeElement<T>(i);
+    }
+    {
+        ConsumerThread consumer([&buffer, out = std::array<T, kBatchSize>{}]() mutable {
+            const auto popped = buffer->try_pop_n(out.data(), out.size());
+            benchmark::DoNotOptimize(out.data());
+            return popped != 0;
+        });
+        for (auto _ : state) {
+            std::size_t pushed = 0;
+            while (pushed < kBatchSize) {
+                const auto n = buffer->try_push_n(batch.data() + pushed, kBatchSize - pushed);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                pushed += n;
+            }
+        }
+    }
+    reportItems(state, static_cast<std::size_t>(state.iterations()) * kBatchSize, sizeof(T));
+}
+
+/// try_reserve_n/commit on the producer, read_span/release on the consumer
+template <std::size_t Capacity, typename T>
+void BM_ReserveCommit(benchmark::State& state) {
+    auto buffer = std::make_unique<lockfree::RingBuffer<T, Capacity>>();
+    const T element = makeElement<T>(1);
+    {
+        ConsumerThread consumer([&buffer]() {
+            const auto region = buffer->read_span();
+            if (region.empty()) {
+                return false;
+            }
+            for (const T& item : region.first) {
+                benchmark::DoNotOptimize(&item);
+            }
+            for (const T& item : region.second) {
+                benchmark::DoNotOptimize(&item);
+            }
+            buffer->release(region.size());
+            return true;
+        });
+        for (auto _ : state) {
+            std::size_t pushed = 0;
+            while (pushed < kBatchSize) {
+                const auto region = buffer->try_reserve_n(kBatchSize - pushed);
+                if (region.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (T& slot : region.first) {
+                    ::new (static_cast<void*>(&slot)) T(element);
+                }
+                for (T& slot : region.second) {
+                    ::new (static_cast<void*>(&slot)) T(element);
+                }
+                buffer->commit(region.size());
+                pushed += region.size();
+            }
+        }
+    }
+    reportItems(state, static_cast<std::size_t>(state.iterations()) * kBatchSize, sizeof(T));
+}
+
+} // namespace
+
+#define SPSC_BENCH_ELEMENTS(Macro, Capacity) \
+    Macro(Capacity, Bytes8)                  \
+    Macro(Capacity, Bytes64)                 \
+    Macro(Capacity, Bytes256)                \
+    Macro(Capacity, NonTrivial)
+
+#define SPSC_BENCH_SWEEP(Macro)          \
+    SPSC_BENCH_ELEMENTS(Macro, 64)       \
+    SPSC_BENCH_ELEMENTS(Macro, 1024)     \
+    SPSC_BENCH_ELEMENTS(Macro, 16384)
+
+#define SPSC_BENCH_RING_OPS(Capacity, T)                              \
+    BENCHMARK_TEMPLATE(BM_Single, LockfreeRing, Capacity, T);         \
+    BENCHMARK_TEMPLATE(BM_Batch, Capacity, T);                        \
+    BENCHMARK_TEMPLATE(BM_ReserveCommit, Capacity, T);
+
+SPSC_BENCH_SWEEP(SPSC_BENCH_RING_OPS)
+
+#ifdef SPSC_BENCH_HAVE_BOOST
+#define SPSC_BENCH_BOOST(Capacity, T) BENCHMARK_TEMPLATE(BM_Single, BoostSpsc, Capacity, T);
+SPSC_BENCH_SWEEP(SPSC_BENCH_BOOST)
+#endif
+
+#ifdef SPSC_BENCH_HAVE_RIGTORP
+#define SPSC_BENCH_RIGTORP(Capacity, T) BENCHMARK_TEMPLATE(BM_Single, RigtorpSpsc, Capacity, T);
+SPSC_BENCH_SWEEP(SPSC_BENCH_RIGTORP)
+#endif
+
+#ifdef SPSC_BENCH_HAVE_FOLLY
+#define SPSC_BENCH_FOLLY(Capacity, T) BENCHMARK_TEMPLATE(BM_Single, FollyPcq, Capacity, T);
+SPSC_BENCH_SWEEP(SPSC_BENCH_FOLLY)
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,157 @@
+/**
+ * @file latency_histogram.hpp
+ * @brief Log-linear latency histogram and cycle clock for the benchmark suite
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LOCKFREE_BENCH_HAVE_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define LOCKFREE_BENCH_HAVE_TSC 1
+#endif
+
+/**
+ * HDR-style histogram of nanosecond latencies
+ *
+ * Values below kSubBuckets are counted exactly; every power-of-two range
+ * above that is split into kHalfBuckets linear buckets, so the reported
+ * percentiles are at most 1/kHalfBuckets (~1.6%) above the true value
+ * regardless of magnitude, while the whole range of uint64_t fits in under
+ * 4K counters. Recording is a couple of shifts and one increment, cheap
+ * enough to do on the consumer's hot path.
+ */
+class LatencyHistogram {
+private:
+    static constexpr unsigned kSubBucketBits = 7;
+    static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+    static constexpr uint64_t kHalfBuckets = kSubBuckets / 2;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits) * kHalfBuckets + kSubBuckets;
+
+    std::vector<uint64_t> counts_;
+    uint64_t total_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+
+    static unsigned highestBit(uint64_t value) {
+        unsigned bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+    }
+
+    static size_t bucketOf(uint64_t value) {
+        if (value < kSubBuckets) {
+            return static_cast<size_t>(value);
+        }
+        const unsigned shift = highestBit(value) - kSubBucketBits + 1;
+        return static_cast<size_t>(shift * kHalfBuckets + (value >> shift));
+    }
+
+    /// Highest value that falls into the given bucket
+    static uint64_t bucketUpperBound(size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return bucket;
+        }
+        const uint64_t shift = bucket / kHalfBuckets - 1;
+        const uint64_t sub = bucket - shift * kHalfBuckets;
+        return (sub << shift) + ((uint64_t{1} << shift) - 1);
+    }
+
+public:
+    LatencyHistogram() : counts_(kBucketCount, 0) {}
+
+    void record(uint64_t value_ns) {
+        ++counts_[bucketOf(value_ns)];
+        ++total_;
+        min_ = std::min(min_, value_ns);
+        max_ = std::max(max_, value_ns);
+    }
+
+    uint64_t count() const { return total_; }
+    uint64_t min() const { return total_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+
+    /**
+     * Value at the given percentile (0-100], reported as the upper bound of
+     * the bucket it falls in. The exact maximum is available from max().
+     */
+    uint64_t percentile(double pct) const {
+        if (total_ == 0) {
+            return 0;
+        }
+        const auto target = std::max<uint64_t>(
+            1, static_cast<uint64_t>(pct / 100.0 * static_cast<double>(total_) + 0.5));
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < counts_.size(); ++bucket) {
+            seen += counts_[bucket];
+            if (seen >= target) {
+                return std::min(bucketUpperBound(bucket), max_);
+            }
+        }
+        return max_;
+    }
+};
+
+/**
+ * Low-overhead timestamp source for latency measurements
+ *
+ * Uses the TSC where available (invariant and synchronised across cores on
+ * any CPU from the last decade), calibrated once against steady_clock, and
+ * falls back to steady_clock elsewhere. Timestamps taken on different cores
+ * are directly comparable either way.
+ */
+class CycleClock {
+private:
+    double ns_per_tick_ = 1.0;
+
+public:
+    CycleClock() {
+#ifdef LOCKFREE_BENCH_HAVE_TSC
+        const auto wall_start = std::chrono::steady_clock::now();
+        const uint64_t tsc_start = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const uint64_t tsc_end = now();
+        const auto wall_end = std::chrono::steady_clock::now();
+        const auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - wall_start);
+        ns_per_tick_ = static_cast<double>(wall_ns.count()) / static_cast<double>(tsc_end - tsc_start);
+#endif
+    }
+
+    static uint64_t now() {
+#ifdef LOCKFREE_BENCH_HAVE_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /// Convert a tick interval to nanoseconds; negative skew clamps to zero
+    uint64_t toNs(uint64_t start, uint64_t end) const {
+        return end > start ? static_cast<uint64_t>(static_cast<double>(end - start) * ns_per_tick_) : 0;
+    }
+
+    uint64_t ticksFor(std::chrono::nanoseconds interval) const {
+        return static_cast<uint64_t>(static_cast<double>(interval.count()) / ns_per_tick_);
+    }
+
+    static const char* name() {
+#ifdef LOCKFREE_BENCH_HAVE_TSC
+        return "rdtsc";
+#else
+        return "steady_clock";
+#endif
+    }
+};
@@ -0,0 +1,164 @@
+/**
+ * @file perf_counters.hpp
+ * @brief Hardware performance counters for the benchmark suite (Linux perf_event_open)
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// Counter deltas over one timed run, in PerfCounters::names() order
+struct PerfRun {
+    std::vector<double> counts;
+    double elapsed_ms = 0.0;
+};
+
+/**
+ * Process-wide hardware counters opened with perf_event_open
+ *
+ * Every event counts user-space work of the opening thread and, through
+ * inherit, of each thread created after it. A thread's counts are folded in
+ * when it exits, so a read after joining the benchmark threads covers them.
+ * Inherited events cannot be read as a group, so each runs on its own and is
+ * scaled by its enabled/running time if the kernel multiplexes the PMU.
+ */
+class PerfCounters {
+private:
+    struct Counter {
+        std::string name;
+        int fd;
+    };
+    std::vector<Counter> counters_;
+
+public:
+    PerfCounters() = default;
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const Counter& counter : counters_) {
+            ::close(counter.fd);
+        }
+#endif
+    }
+
+    /**
+     * Open cycles, instructions, L1D read misses, LLC misses and branch
+     * misses, plus the model-specific raw event hitm_config (reported as
+     * HITM) if it is nonzero. Events the CPU lacks are skipped.
+     *
+     * @return Empty on success, otherwise why no event could be opened
+     */
+    std::string open(uint64_t hitm_config) {
+#if defined(__linux__)
+        struct Event {
+            const char* name;
+            uint32_t type;
+            uint64_t config;
+        };
+        const Event events[] = {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instr", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"L1D-miss", PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {"LLC-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+            {"br-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {"HITM", PERF_TYPE_RAW, hitm_config},
+        };
+
+        std::string error;
+        for (const Event& event : events) {
+            if (event.type == PERF_TYPE_RAW && event.config == 0) {
+                continue;
+            }
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = event.type;
+            attr.config = event.config;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            const int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd < 0) {
+                error = std::string(event.name) + ": " + std::strerror(errno);
+                continue;
+            }
+            counters_.push_back({event.name, fd});
+        }
+        return counters_.empty() ? error : std::string();
+#else
+        (void)hitm_config;
+        return "perf_event_open is only available on Linux";
+#endif
+    }
+
+    bool isOpen() const { return !counters_.empty(); }
+
+    /// Short names of the opened events
+    std::vector<std::string> names() const {
+        std::vector<std::string> result;
+        for (const Counter& counter : counters_) {
+            result.push_back(counter.name);
+        }
+        return result;
+    }
+
+    /// Current totals, scaled for multiplexing
+    std::vector<double> read() const {
+        std::vector<double> result;
+#if defined(__linux__)
+        for (const Counter& counter : counters_) {
+            uint64_t values[3] = {};  // value, time enabled, time running
+            double scaled = 0.0;
+            if (::read(counter.fd, values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) &&
+                values[2] != 0) {
+                scaled = static_cast<double>(values[0]) * static_cast<double>(values[1]) /
+                         static_cast<double>(values[2]);
+            }
+            result.push_back(scaled);
+        }
+#endif
+        return result;
+    }
+};
+
+/**
+ * Format a run's counters per operation, plus instructions per cycle
+ * when both are counted, e.g. "cycles 41.2  instr 63.0  IPC 1.53  ..."
+ */
+inline std::string formatPerfRun(const std::vector<std::string>& names, const PerfRun& run, double operations) {
+    if (run.counts.size() != names.size() || operations <= 0.0) {
+        return "";
+    }
+    std::ostringstream out;
+    out << std::fixed;
+    double cycles = 0.0;
+    double instructions = 0.0;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const double per_op = run.counts[i] / operations;
+        out << (i == 0 ? "" : "  ") << names[i] << " " << std::setprecision(per_op < 10.0 ? 3 : 1) << per_op;
+        if (names[i] == "cycles") cycles = run.counts[i];
+        if (names[i] == "instr") instructions = run.counts[i];
+    }
+    if (cycles > 0.0 && instructions > 0.0) {
+        out << "  IPC " << std::setprecision(2) << instructions / cycles;
+    }
+    return out.str();
+}
@@ -0,0 +1,302 @@
+/**
+ * @file async_ring_buffer.hpp
+ * @brief SPSC ring buffer with co_await-able push and pop (C++20)
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "async_ring_buffer.hpp requires C++20 coroutines"
+#endif
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+
+/**
+ * @brief Resume a woken coroutine immediately, on the thread that woke it
+ *
+ * An executor is any callable taking a std::coroutine_handle<> that
+ * arranges for handle.resume() to be called, e.g. by posting it to an event
+ * loop or writing to an eventfd the loop polls. It runs on the other side's
+ * thread, inside its push or pop, and must not throw.
+ */
+struct InlineExecutor {
+    void operator()(std::coroutine_handle<> handle) const noexcept {
+        handle.resume();
+    }
+};
+
+namespace detail {
+
+/**
+ * Slot for the one coroutine that may be parked on a ring direction. The
+ * parking side publishes its handle and then re-checks the ring; the other
+ * side publishes progress and then checks the slot. The seq_cst fences on
+ * both sides guarantee that at least one of them notices the other, and the
+ * exchange decides which of them resumes the coroutine. The handle store is
+ * also the release edge that hands the coroutine over: a waker whose
+ * exchange reads it sees everything written before suspension, so the
+ * coroutine can resume on the waker's thread.
+ */
+class CoroutineWaiter {
+    std::atomic<void*> handle_{nullptr};
+
+public:
+    /**
+     * Park handle unless ready() turns true meanwhile. Returns true if the
+     * coroutine stays suspended (it now belongs to the waker) and false if it
+     * was taken back and should continue at once.
+     */
+    template <typename Ready>
+    [[nodiscard]] bool park(std::coroutine_handle<> handle, Ready&& ready) noexcept {
+        handle_.store(handle.address(), std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) {
+            return true;
+        }
+        // If the waker got here first, it resumes the coroutine
+        return handle_.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+    }
+
+    /**
+     * Hand the parked coroutine, if any, to executor once ready() holds; call
+     * after publishing progress. The handle taken may come from a later park
+     * than the one this progress was meant for, after the parking side took
+     * the earlier one back and consumed that progress itself. Only the waker
+     * can make ready() true again, so such a handle is put back to wait for
+     * the next wake.
+     */
+    template <typename Executor, typename Ready>
+    void wake(Executor& executor, Ready&& ready) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (handle_.load(std::memory_order_relaxed) == nullptr) {
+            return;
+        }
+        void* address = handle_.exchange(nullptr, std::memory_order_acq_rel);
+        if (address == nullptr) {
+            return;
+        }
+        if (!ready()) {
+            handle_.store(address, std::memory_order_release);
+            return;
+        }
+        executor(std::coroutine_handle<>::from_address(address));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief SPSC ring buffer whose consumer and producer can be coroutines
+ *
+ * co_await async_pop() on an empty ring (or async_push() on a full one)
+ * parks the coroutine instead of spinning, so the worker thread is free to
+ * run other coroutines and an idle queue costs no CPU. The other side's next
+ * push (or pop) hands the parked coroutine to the executor, which decides
+ * where it resumes.
+ *
+ * Each direction has a single waiter slot, which is all SPSC needs: at most
+ * one coroutine may await async_pop() and at most one async_push() at a
+ * time. All pushes and pops must go through this class (not the underlying
+ * ring) so that parked coroutines are woken. Waking costs a seq_cst fence
+ * per push and pop, as with SpinSleepWait.
+ *
+ * @tparam T Type of elements stored in the buffer
+ * @tparam Capacity Number of slots (must be a power of 2)
+ * @tparam Traits Compile-time tuning options for the underlying RingBuffer
+ * @tparam Executor How woken coroutines are resumed, see InlineExecutor
+ *
+ * @warning The ring must outlive any coroutine parked on it.
+ *
+ * Example usage:
+ * @code
+ * auto post = [&loop](std::coroutine_handle<> h) { loop.post(h); };
+ * lockfree::AsyncRingBuffer<Request, 1024, lockfree::RingBufferTraits, decltype(post)> requests(post);
+ *
+ * Task session(auto& requests) {
+ *     while (true) {
+ *         Request request = co_await requests.async_pop();
+ *         handle(request);
+ *     }
+ * }
+ * @endcode
+ */
+template <typename T, std::size_t Capacity, typename Traits = RingBufferTraits,
+          typename Executor = InlineExecutor>
+class AsyncRingBuffer {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using ring_type = RingBuffer<T, Capacity, Traits>;
+
+private:
+    ring_type ring_;
+    alignas(Traits::kCacheLineSize) detail::CoroutineWaiter consumer_;  ///< Parked in async_pop()
+    alignas(Traits::kCacheLineSize) detail::CoroutineWaiter producer_;  ///< Parked in async_push()
+    [[no_unique_address]] Executor executor_;
+
+public:
+    /// Awaitable returned by async_pop(); yields the popped element
+    class PopAwaiter {
+        AsyncRingBuffer& owner_;
+        std::optional<T> item_;
+
+    public:
+        explicit PopAwaiter(AsyncRingBuffer& owner) noexcept : owner_(owner) {}
+
+        bool await_ready() {
+            item_ = owner_.try_pop();
+            return item_.has_value();
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept {
+            // Once parked, the coroutine may be resumed and this awaiter
+            // destroyed at any moment, so the re-check must not touch *this
+            const auto& ring = owner_.ring_;
+            return owner_.consumer_.park(handle, [&ring] { return !ring.empty(); });
+        }
+
+        T await_resume() {
+            if (!item_) {
+                // Woken (or taken back) only once an element is readable
+                item_ = owner_.try_pop();
+            }
+            return std::move(*item_);
+        }
+    };
+
+    /// Awaitable returned by async_push(); completes once the element is in the ring
+    class PushAwaiter {
+        AsyncRingBuffer& owner_;
+        T item_;
+        bool pushed_ = false;
+
+    public:
+        PushAwaiter(AsyncRingBuffer& owner, T item) noexcept(std::is_nothrow_move_constructible_v<T>)
+            : owner_(owner), item_(std::move(item)) {}
+
+        bool await_ready() {
+            pushed_ = owner_.try_push(std::move(item_));
+            return pushed_;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept {
+            // As in PopAwaiter, *this may be gone as soon as the handle is parked
+            const auto& ring = owner_.ring_;
+            return owner_.producer_.park(handle, [&ring] { return !ring.full(); });
+        }
+
+        void await_resume() {
+            if (!pushed_) {
+                // Woken (or taken back) only once a slot is free
+                pushed_ = owner_.try_push(std::move(item_));
+            }
+        }
+    };
+
+    /**
+     * @brief Construct an empty ring
+     *
+     * @param executor Resumes coroutines woken by the other side
+     */
+    explicit AsyncRingBuffer(Executor executor = Executor()) noexcept(
+        std::is_nothrow_default_constructible_v<ring_type> && std::is_nothrow_move_constructible_v<Executor>)
+        : executor_(std::move(executor)) {}
+
+    AsyncRingBuffer(const AsyncRingBuffer&) = delete;
+    AsyncRingBuffer& operator=(const AsyncRingBuffer&) = delete;
+    AsyncRingBuffer(AsyncRingBuffer&&) = delete;
+    AsyncRingBuffer& operator=(AsyncRingBuffer&&) = delete;
+
+    /**
+     * @brief Construct an element in place, waking a parked consumer
+     *
+     * @return true if the element was added, false if the ring is full
+     *
+     * @note This function should only be called from the producer side
+     */
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        if (!ring_.try_emplace(std::forward<Args>(args)...)) {
+            return false;
+        }
+        consumer_.wake(executor_, [this] { return !ring_.empty(); });
+        return true;
+    }
+
+    /// Copy an element in, waking a parked consumer; false if the ring is full
+    [[nodiscard]] bool try_push(const T& item) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return try_emplace(item);
+    }
+
+    /// Move an element in, waking a parked consumer; false if the ring is full
+    [[nodiscard]] bool try_push(T&& item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return try_emplace(std::move(item));
+    }
+
+    /**
+     * @brief Remove the oldest element, waking a parked producer
+     *
+     * @return The element, or std::nullopt if the ring is empty
+     *
+     * @note This function should only be called from the consumer side
+     */
+    [[nodiscard]] std::optional<T> try_pop() noexcept(std::is_nothrow_move_constructible_v<T>) {
+        auto item = ring_.try_pop();
+        if (item) {
+            producer_.wake(executor_, [this] { return !ring_.full(); });
+        }
+        return item;
+    }
+
+    /**
+     * @brief Pop an element, suspending the calling coroutine while the ring is empty
+     *
+     * @return An awaitable; co_await it once and only from the consumer side
+     */
+    [[nodiscard]] PopAwaiter async_pop() noexcept {
+        return PopAwaiter(*this);
+    }
+
+    /**
+     * @brief Push an element, suspending the calling coroutine while the ring is full
+     *
+     * @return An awaitable; co_await it once and only from the producer side
+     */
+    [[nodiscard]] PushAwaiter async_push(T item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return PushAwaiter(*this, std::move(item));
+    }
+
+    /// Whether the ring appears empty (approximate, as RingBuffer::empty())
+    [[nodiscard]] bool empty() const noexcept {
+        return ring_.empty();
+    }
+
+    /// Whether the ring appears full (approximate, as RingBuffer::full())
+    [[nodiscard]] bool full() const noexcept {
+        return ring_.full();
+    }
+
+    /// Approximate number of elements in the ring
+    [[nodiscard]] size_type size() const noexcept {
+        return ring_.size();
+    }
+
+    /// Maximum number of elements the ring holds
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return ring_type::capacity();
+    }
+};
+
+} // namespace lockfree
@@ -0,0 +1,461 @@
+/**
+ * @file broadcast_ring_buffer.hpp
+ * @brief Single-producer ring buffer delivering every element to several readers
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+#include "seqlock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+
+/**
+ * @brief What the producer of a BroadcastRingBuffer does about slow readers
+ */
+enum class BroadcastMode {
+    kGated,  ///< The producer waits for the slowest reader, nothing is lost
+    kLossy,  ///< The producer never waits; a reader that falls a lap behind skips ahead
+};
+
+/**
+ * @brief Lock-free ring buffer with one producer and a fixed set of readers
+ *
+ * Every reader sees every element (disruptor-style): the producer writes each
+ * element once, and each reader advances its own cursor, kept on its own cache
+ * line, over the shared slots. Fan-out therefore costs one write per element
+ * instead of one copy per consumer, whatever the element size.
+ *
+ * In BroadcastMode::kGated the producer only reuses a slot once every reader
+ * has passed it, so the slowest reader gates the producer (try_push returns
+ * false, push waits). The producer keeps a cached copy of the slowest cursor
+ * and only rescans the readers when that copy says the ring is full.
+ *
+ * In BroadcastMode::kLossy the producer always writes, overwriting the oldest
+ * slot. Each slot carries a version (seqlock-style) that the reader checks
+ * around its copy, so it never returns a torn element; a reader that has been
+ * lapped skips to the oldest element still in the ring and counts what it
+ * missed in dropped(). T must be trivially copyable in this mode.
+ *
+ * @tparam T Type of elements stored in the buffer
+ * @tparam Capacity Number of slots (must be a power of 2); all are usable
+ * @tparam Readers Number of readers
+ * @tparam Mode Gated or lossy handling of slow readers
+ * @tparam Traits Tuning knobs; only WaitPolicy is used and it must be a
+ *         spinning policy (not SpinSleepWait)
+ *
+ * Example usage:
+ * @code
+ * lockfree::BroadcastRingBuffer<Fill, 4096, 3> fills;
+ *
+ * // Producer
+ * fills.push(fill);
+ *
+ * // Persistence, risk and analytics threads, one reader each
+ * auto reader = fills.reader(k);
+ * while (auto fill = reader.try_pop()) { handle(*fill); }
+ * @endcode
+ *
+ * @warning In gated mode every reader index must be drained, or the producer
+ *          stops once the ring is full.
+ */
+template <typename T, std::size_t Capacity, std::size_t Readers,
+          BroadcastMode Mode = BroadcastMode::kGated, typename Traits = RingBufferTraits>
+class BroadcastRingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 1,
+                  "Capacity must be a power of 2 and greater than 1");
+    static_assert(Readers > 0, "A broadcast ring needs at least one reader");
+    static_assert(std::is_nothrow_destructible_v<T>,
+                  "T must be nothrow destructible");
+    static_assert(Mode != BroadcastMode::kLossy || std::is_trivially_copyable_v<T>,
+                  "Lossy broadcast rings copy slots that may be overwritten, so T must be trivially copyable");
+    static_assert(std::is_empty_v<typename Traits::WaitPolicy::State>,
+                  "Broadcast rings support spinning wait policies only (not SpinSleepWait)");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+private:
+    static constexpr bool kLossy = Mode == BroadcastMode::kLossy;
+    static constexpr size_type kIndexMask = Capacity - 1;
+
+    using WaitPolicy = typename Traits::WaitPolicy;
+
+    struct GatedCell {
+        detail::Slot<T> storage;
+    };
+
+    using Cell = std::conditional_t<kLossy, detail::VersionedSlot<T>, GatedCell>;
+
+    struct alignas(detail::kCacheLineSize) Cursor {
+        std::atomic<size_type> head{0};  ///< Next position this reader reads
+        size_type tail_cache{0};         ///< Reader's copy of tail_
+        size_type dropped{0};            ///< Elements skipped after being lapped
+    };
+
+    alignas(detail::kCacheLineSize) std::atomic<size_type> tail_{0};  ///< Next position to write
+    size_type gate_cache_{0};       ///< Producer's copy of the slowest reader's cursor
+    size_type destroyed_up_to_{0};  ///< Elements before this position are destroyed (gated)
+
+    Cursor cursors_[Readers];
+    alignas(detail::kCacheLineSize) Cell cells_[Capacity];
+
+    [[nodiscard]] Cell& cell(size_type position) noexcept {
+        return cells_[position & kIndexMask];
+    }
+
+    [[nodiscard]] T* element(size_type position) noexcept {
+        return std::launder(reinterpret_cast<T*>(cell(position).storage.bytes));
+    }
+
+    template <typename Ready>
+    static void wait_until(Ready&& ready) {
+        typename WaitPolicy::State state;
+        WaitPolicy::wait(state, ready, detail::NoDeadline{});
+    }
+
+    /// Cursor of the reader furthest behind tail
+    [[nodiscard]] size_type slowest_head(size_type tail) const noexcept {
+        size_type slowest = tail;
+        for (const auto& cursor : cursors_) {
+            const auto head = cursor.head.load(std::memory_order_acquire);
+            if (tail - head > tail - slowest) {
+                slowest = head;
+            }
+        }
+        return slowest;
+    }
+
+    /// Gated producer: whether the slot at tail is free, rescanning readers if needed
+    [[nodiscard]] bool has_space(size_type tail) noexcept {
+        if (tail - gate_cache_ < Capacity) {
+            return true;
+        }
+        gate_cache_ = slowest_head(tail);
+        return tail - gate_cache_ < Capacity;
+    }
+
+    /// Write the element at tail and publish it; the slot must be free (gated)
+    template <typename... Args>
+    void write(size_type tail, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        if constexpr (kLossy) {
+            cell(tail).store(tail, std::forward<Args>(args)...);
+        } else {
+            // Every reader has passed the element one lap back, so retire it.
+            // Tracked separately so a throwing constructor does not destroy it twice.
+            if (tail - destroyed_up_to_ >= Capacity) {
+                element(destroyed_up_to_)->~T();
+                ++destroyed_up_to_;
+            }
+            ::new (static_cast<void*>(cell(tail).storage.bytes)) T(std::forward<Args>(args)...);
+        }
+        tail_.store(tail + 1, std::memory_order_release);
+    }
+
+public:
+    /**
+     * @brief Handle through which one reader consumes the broadcast stream
+     *
+     * The handle is cheap to copy, but each reader index must be used by
+     * at most one thread at a time.
+     */
+    class Reader {
+        friend BroadcastRingBuffer;
+
+        BroadcastRingBuffer* ring_;
+        Cursor* cursor_;
+
+        Reader(BroadcastRingBuffer& ring, Cursor& cursor) noexcept : ring_(&ring), cursor_(&cursor) {}
+
+        /// Whether an element is available at head, refreshing tail_cache if needed
+        [[nodiscard]] bool has_data(size_type head) noexcept {
+            if (head != cursor_->tail_cache) {
+                return true;
+            }
+            cursor_->tail_cache = ring_->tail_.load(std::memory_order_acquire);
+            return head != cursor_->tail_cache;
+        }
+
+        /// Lossy reader: copy the element at head, skipping ahead when lapped
+        [[nodiscard]] std::optional<T> read_versioned(size_type head) noexcept {
+            // More than a lap behind: head's slot already holds a later element
+            bool lapped = cursor_->tail_cache - head > Capacity;
+            while (true) {
+                if (lapped) {
+                    // Resume at the oldest slot the producer cannot be writing
+                    const auto oldest = cursor_->tail_cache - Capacity + 1;
+                    cursor_->dropped += oldest - head;
+                    head = oldest;
+                }
+                detail::Slot<T> copy;
+                if (ring_->cell(head).load(head, copy)) {
+                    cursor_->head.store(head + 1, std::memory_order_relaxed);
+                    return detail::VersionedSlot<T>::element(copy);
+                }
+                // The producer has started on the slot a lap later
+                cursor_->tail_cache = ring_->tail_.load(std::memory_order_acquire);
+                lapped = true;
+            }
+        }
+
+    public:
+        /**
+         * @brief Attempt to read the next element
+         *
+         * @return A copy of the element, or std::nullopt if this reader has
+         *         seen everything published so far
+         */
+        [[nodiscard]] std::optional<T> try_pop() noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            const auto head = cursor_->head.load(std::memory_order_relaxed);
+            if (!has_data(head)) {
+                return std::nullopt;
+            }
+            if constexpr (kLossy) {
+                return read_versioned(head);
+            } else {
+                std::optional<T> result(*ring_->element(head));
+                cursor_->head.store(head + 1, std::memory_order_release);
+                return result;
+            }
+        }
+
+        /**
+         * @brief Read the next element, waiting for one if necessary
+         */
+        [[nodiscard]] T pop() {
+            while (true) {
+                if (auto item = try_pop()) {
+                    return std::move(*item);
+                }
+                const auto head = cursor_->head.load(std::memory_order_relaxed);
+                wait_until([&] { return has_data(head); });
+            }
+        }
+
+        /**
+         * @brief Peek at the next element in place (gated mode only)
+         *
+         * @return Pointer to the element, or nullptr if there is none. It
+         *         stays valid until pop_front() or release().
+         */
+        [[nodiscard]] const T* front() noexcept {
+            static_assert(!kLossy, "Lossy readers cannot read in place; use try_pop()");
+            const auto head = cursor_->head.load(std::memory_order_relaxed);
+            return has_data(head) ? ring_->element(head) : nullptr;
+        }
+
+        /**
+         * @brief Move past the element returned by front() (gated mode only)
+         */
+        void pop_front() noexcept {
+            release(1);
+        }
+
+        /**
+         * @brief View every element this reader has not seen yet, in place
+         *        (gated mode only)
+         *
+         * @return Up to two segments, valid until release()
+         */
+        [[nodiscard]] Region<const T> read_span() noexcept {
+            static_assert(!kLossy, "Lossy readers cannot read in place; use try_pop()");
+            const auto head = cursor_->head.load(std::memory_order_relaxed);
+            const auto count = has_data(head) ? cursor_->tail_cache - head : 0;
+            const auto start = head & kIndexMask;
+            const auto first_run = std::min(count, Capacity - start);
+            return {{ring_->element(head), first_run}, {ring_->element(0), count - first_run}};
+        }
+
+        /**
+         * @brief Move past n elements seen through read_span() (gated mode only)
+         *
+         * @warning n must not exceed the size of the last read_span().
+         */
+        void release(size_type n) noexcept {
+            static_assert(!kLossy, "Lossy readers cannot read in place; use try_pop()");
+            const auto head = cursor_->head.load(std::memory_order_relaxed);
+            cursor_->head.store(head + n, std::memory_order_release);
+        }
+
+        /**
+         * @brief Check if this reader appears to have seen every element
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return cursor_->head.load(std::memory_order_relaxed) ==
+                   ring_->tail_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Get the approximate number of elements this reader is behind
+         *
+         * In lossy mode this is capped at Capacity; anything beyond has been
+         * overwritten.
+         */
+        [[nodiscard]] size_type size() const noexcept {
+            const auto head = cursor_->head.load(std::memory_order_relaxed);
+            const auto tail = ring_->tail_.load(std::memory_order_relaxed);
+            return std::min(tail - head, Capacity);
+        }
+
+        /**
+         * @brief Get the number of elements this reader skipped after being
+         *        lapped by the producer (always 0 in gated mode)
+         */
+        [[nodiscard]] size_type dropped() const noexcept {
+            return cursor_->dropped;
+        }
+    };
+
+    /**
+     * @brief Default constructor
+     *
+     * All readers start at the beginning of the stream. The element storage
+     * is left uninitialized.
+     */
+    BroadcastRingBuffer() noexcept {}
+
+    BroadcastRingBuffer(const BroadcastRingBuffer&) = delete;
+    BroadcastRingBuffer& operator=(const BroadcastRingBuffer&) = delete;
+    BroadcastRingBuffer(BroadcastRingBuffer&&) = delete;
+    BroadcastRingBuffer& operator=(BroadcastRingBuffer&&) = delete;
+
+    /**
+     * @brief Destructor
+     *
+     * Destroys the elements still held in the slots. Must not run
+     * concurrently with the producer or any reader.
+     */
+    ~BroadcastRingBuffer() {
+        if constexpr (!kLossy && !std::is_trivially_destructible_v<T>) {
+            const auto tail = tail_.load(std::memory_order_acquire);
+            for (auto position = destroyed_up_to_; position != tail; ++position) {
+                element(position)->~T();
+            }
+        }
+    }
+
+    /**
+     * @brief Get the handle of one reader
+     *
+     * @param index Reader index in [0, reader_count())
+     * @throws std::out_of_range if index is not a valid reader index
+     */
+    [[nodiscard]] Reader reader(size_type index) {
+        if (index >= Readers) {
+            throw std::out_of_range("BroadcastRingBuffer::reader: reader index out of range");
+        }
+        return Reader(*this, cursors_[index]);
+    }
+
+    /**
+     * @brief Attempt to construct an element in place
+     *
+     * @return true if the element was published, false if the slowest reader
+     *         is a full lap behind (never false in lossy mode)
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if constexpr (!kLossy) {
+            if (!has_space(tail)) {
+                return false;
+            }
+        }
+        write(tail, std::forward<Args>(args)...);
+        return true;
+    }
+
+    /**
+     * @brief Attempt to publish an element (copy version)
+     *
+     * @return true if successful, false if the slowest reader is a full lap behind
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] bool try_push(const T& item) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return try_emplace(item);
+    }
+
+    /**
+     * @brief Attempt to publish an element (move version)
+     *
+     * @return true if successful, false if the slowest reader is a full lap behind
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] bool try_push(T&& item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return try_emplace(std::move(item));
+    }
+
+    /**
+     * @brief Construct an element in place, waiting for the slowest reader
+     *        in gated mode
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if constexpr (!kLossy) {
+            wait_until([&] { return has_space(tail); });
+        }
+        write(tail, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Publish an element, waiting for the slowest reader in gated mode
+     *
+     * @note This function should only be called from the producer thread
+     */
+    void push(const T& item) {
+        emplace(item);
+    }
+
+    /**
+     * @brief Publish an element (move version), waiting for the slowest
+     *        reader in gated mode
+     *
+     * @note This function should only be called from the producer thread
+     */
+    void push(T&& item) {
+        emplace(std::move(item));
+    }
+
+    /**
+     * @brief Get the number of elements published so far
+     */
+    [[nodiscard]] size_type published() const noexcept {
+        return tail_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of readers
+     */
+    [[nodiscard]] static constexpr size_type reader_count() noexcept {
+        return Readers;
+    }
+
+    /**
+     * @brief Get the number of slots
+     */
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return Capacity;
+    }
+};
+
+} // namespace lockfree
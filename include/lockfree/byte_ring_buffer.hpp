@@ -0,0 +1,269 @@
+/**
+ * @file byte_ring_buffer.hpp
+ * @brief Lock-free SPSC ring buffer for variable-length messages
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace lockfree {
+
+/**
+ * @brief Lock-free SPSC ring buffer of length-prefixed byte records
+ *
+ * Messages of any size up to max_message_size() are packed back to back
+ * instead of each taking a fixed-size slot. Every record is an 8-byte header
+ * holding the payload length, followed by the payload, rounded up to 8 bytes
+ * so payloads are always 8-byte aligned. A record never wraps: when it does
+ * not fit before the end of the storage the producer writes a padding marker
+ * and starts the record at offset 0, so every payload is one contiguous span.
+ *
+ * The head/tail protocol is the same as RingBuffer's: free-running byte
+ * counters on separate cache lines, each side keeping a cached copy of the
+ * other side's counter.
+ *
+ * @tparam Capacity Size of the storage in bytes (must be a power of 2, at least 64)
+ *
+ * Example usage:
+ * @code
+ * lockfree::ByteRingBuffer<1 << 20> ring;
+ *
+ * // Producer: build the message in place
+ * if (void* p = ring.try_reserve(sizeof(OrderHeader) + legs * sizeof(Leg))) {
+ *     auto* order = new (p) OrderHeader{...};
+ *     ...
+ *     ring.commit(sizeof(OrderHeader) + legs * sizeof(Leg));
+ * }
+ *
+ * // Consumer: read in place, then release
+ * auto message = ring.read();
+ * if (message.data) {
+ *     handle(message.data, message.size);
+ *     ring.release();
+ * }
+ * @endcode
+ */
+template <std::size_t Capacity>
+class ByteRingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity >= 64,
+                  "Capacity must be a power of 2 and at least 64 bytes");
+    static_assert(Capacity / 2 <= std::numeric_limits<std::uint32_t>::max(),
+                  "Record lengths must fit the 32-bit header");
+
+public:
+    using size_type = std::size_t;
+    /// A message payload; data is nullptr when no message is available
+    using message_type = Segment<const unsigned char>;
+
+    /// Bytes of header in front of every record
+    static constexpr size_type kHeaderSize = 8;
+    /// Alignment of every record, and therefore of every payload
+    static constexpr size_type kRecordAlignment = 8;
+
+private:
+    /// Header length value marking the rest of the storage as unused
+    static constexpr std::uint32_t kPaddingMarker = std::numeric_limits<std::uint32_t>::max();
+    static constexpr size_type kIndexMask = Capacity - 1;
+
+    alignas(detail::kCacheLineSize) std::atomic<size_type> head_{0};  ///< Consumer byte counter
+    size_type tail_cache_{0};    ///< Consumer's copy of tail_
+    size_type read_end_{0};      ///< End of the record returned by read()
+    alignas(detail::kCacheLineSize) std::atomic<size_type> tail_{0};  ///< Producer byte counter
+    size_type head_cache_{0};    ///< Producer's copy of head_
+    size_type reserved_at_{0};   ///< Start of the record returned by try_reserve()
+
+    // Message storage aligned to cache line boundary, left uninitialized
+    alignas(detail::kCacheLineSize) unsigned char data_[Capacity];
+
+    [[nodiscard]] static constexpr size_type record_size(size_type payload) noexcept {
+        return (kHeaderSize + payload + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+    }
+
+    void write_length(size_type position, std::uint32_t length) noexcept {
+        std::memcpy(data_ + (position & kIndexMask), &length, sizeof(length));
+    }
+
+    [[nodiscard]] std::uint32_t read_length(size_type position) const noexcept {
+        std::uint32_t length;
+        std::memcpy(&length, data_ + (position & kIndexMask), sizeof(length));
+        return length;
+    }
+
+    /// Whether bytes more bytes can be written at tail, refreshing head_cache_ if needed
+    [[nodiscard]] bool has_space(size_type tail, size_type bytes) noexcept {
+        if (Capacity - (tail - head_cache_) >= bytes) {
+            return true;
+        }
+        head_cache_ = head_.load(std::memory_order_acquire);
+        return Capacity - (tail - head_cache_) >= bytes;
+    }
+
+    /// Whether a record is available at head, refreshing tail_cache_ if needed
+    [[nodiscard]] bool has_record(size_type head) noexcept {
+        if (head != tail_cache_) {
+            return true;
+        }
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        return head != tail_cache_;
+    }
+
+public:
+    /**
+     * @brief Default constructor
+     *
+     * The storage is left uninitialized until messages are written.
+     */
+    ByteRingBuffer() noexcept {}
+
+    ByteRingBuffer(const ByteRingBuffer&) = delete;
+    ByteRingBuffer& operator=(const ByteRingBuffer&) = delete;
+    ByteRingBuffer(ByteRingBuffer&&) = delete;
+    ByteRingBuffer& operator=(ByteRingBuffer&&) = delete;
+
+    /**
+     * @brief Reserve contiguous space for a message of up to bytes bytes
+     *
+     * The message becomes visible to the consumer only after commit(). Until
+     * then, calling try_reserve() again replaces the reservation.
+     *
+     * @param bytes Payload size to reserve
+     * @return 8-byte aligned pointer to the payload space, or nullptr if there
+     *         is not enough free space (always nullptr if bytes exceeds
+     *         max_message_size())
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] void* try_reserve(size_type bytes) noexcept {
+        if (bytes > max_message_size()) {
+            return nullptr;
+        }
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        const auto needed = record_size(bytes);
+        const auto until_end = Capacity - (current_tail & kIndexMask);
+        const auto padding = needed > until_end ? until_end : 0;
+        if (!has_space(current_tail, padding + needed)) {
+            return nullptr;
+        }
+        if (padding != 0) {
+            write_length(current_tail, kPaddingMarker);
+        }
+        reserved_at_ = current_tail + padding;
+        return data_ + (reserved_at_ & kIndexMask) + kHeaderSize;
+    }
+
+    /**
+     * @brief Publish the message written into the last try_reserve() space
+     *
+     * @param bytes Actual payload size, which may be smaller than reserved
+     *
+     * @warning bytes must not exceed the size passed to the last successful
+     *          try_reserve(), and each reservation may be committed once.
+     *
+     * @note This function should only be called from the producer thread
+     */
+    void commit(size_type bytes) noexcept {
+        write_length(reserved_at_, static_cast<std::uint32_t>(bytes));
+        tail_.store(reserved_at_ + record_size(bytes), std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy a message into the buffer
+     *
+     * @return true if the message was written, false if there was not enough space
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] bool try_push(const void* data, size_type bytes) noexcept {
+        void* space = try_reserve(bytes);
+        if (!space) {
+            return false;
+        }
+        if (bytes != 0) {
+            std::memcpy(space, data, bytes);
+        }
+        commit(bytes);
+        return true;
+    }
+
+    /**
+     * @brief View the oldest message in place
+     *
+     * Calling read() again before release() returns the same message.
+     *
+     * @return The message payload, valid until release(); its data is
+     *         nullptr if the buffer is empty
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] message_type read() noexcept {
+        auto current_head = head_.load(std::memory_order_relaxed);
+        if (!has_record(current_head)) {
+            return {};
+        }
+        auto length = read_length(current_head);
+        if (length == kPaddingMarker) {
+            // Padding is only published together with the record after it
+            current_head += Capacity - (current_head & kIndexMask);
+            length = read_length(current_head);
+        }
+        read_end_ = current_head + record_size(length);
+        return {data_ + (current_head & kIndexMask) + kHeaderSize, length};
+    }
+
+    /**
+     * @brief Remove the message returned by the last read()
+     *
+     * @warning read() must have returned a message since the last release().
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    void release() noexcept {
+        head_.store(read_end_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Check if the buffer appears empty
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the approximate number of bytes in use, headers and padding included
+     */
+    [[nodiscard]] size_type size_bytes() const noexcept {
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto tail = tail_.load(std::memory_order_acquire);
+        return std::min(tail - head, Capacity);
+    }
+
+    /**
+     * @brief Get the storage size in bytes
+     */
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return Capacity;
+    }
+
+    /**
+     * @brief Get the largest payload that can be written
+     *
+     * Limited to half the storage so a record can always be placed after the
+     * consumer catches up, wherever the wrap point falls.
+     */
+    [[nodiscard]] static constexpr size_type max_message_size() noexcept {
+        return Capacity / 2 - kHeaderSize;
+    }
+};
+
+} // namespace lockfree
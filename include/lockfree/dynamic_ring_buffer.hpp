@@ -0,0 +1,161 @@
+/**
+ * @file dynamic_ring_buffer.hpp
+ * @brief SPSC ring buffer with runtime capacity and allocator-backed storage
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace lockfree {
+
+/**
+ * @brief Lock-free SPSC ring buffer whose capacity is chosen at construction
+ *
+ * Same API and hot path as RingBuffer, but the slot storage is allocated
+ * through a user-supplied allocator instead of being embedded in the object.
+ * Large buffers therefore never end up on the stack, and queue depth can be
+ * tuned from configuration without recompiling.
+ *
+ * The allocator is rebound to a cache-line-sized block type, so the storage
+ * always starts on a cache line boundary. Any standard-conforming allocator
+ * works; PageAllocator (page_allocator.hpp) gives huge-page, NUMA-bound,
+ * prefaulted or locked storage.
+ *
+ * @tparam T The type of elements stored in the ring buffer
+ * @tparam Allocator Allocator used for the slot storage (rebound internally)
+ * @tparam Traits Compile-time tuning options, see RingBufferTraits
+ *
+ * Example usage:
+ * @code
+ * #include <lockfree/dynamic_ring_buffer.hpp>
+ *
+ * lockfree::DynamicRingBuffer<Message> buffer(config.queue_depth);
+ * @endcode
+ */
+template <typename T, typename Allocator = std::allocator<T>, typename Traits = RingBufferTraits>
+class DynamicRingBuffer
+    : public detail::RingBufferCore<DynamicRingBuffer<T, Allocator, Traits>, T, Traits> {
+    using Core = detail::RingBufferCore<DynamicRingBuffer, T, Traits>;
+    using slot_type = typename Core::slot_type;
+    friend Core;
+
+    static constexpr std::size_t kBlockSize = std::max(Traits::kCacheLineSize, alignof(slot_type));
+
+    /// Allocation unit: one cache line (or more for over-aligned T)
+    struct alignas(kBlockSize) StorageBlock {
+        unsigned char bytes[kBlockSize];
+    };
+
+    using BlockAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<StorageBlock>;
+    using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+    // Read-only after construction; kept off the index cache lines so both
+    // sides can hold it in their caches in the shared state.
+    alignas(Traits::kCacheLineSize) slot_type* slots_ = nullptr;
+    std::size_t index_mask_;
+    std::size_t block_count_;
+    BlockAllocator allocator_;
+    typename BlockTraits::pointer blocks_;
+
+    [[nodiscard]] std::size_t index_mask() const noexcept {
+        return index_mask_;
+    }
+
+    [[nodiscard]] slot_type* slot_data() noexcept {
+        return slots_;
+    }
+
+    static std::size_t validate_capacity(std::size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("DynamicRingBuffer capacity must be a power of 2 and greater than 1");
+        }
+        if (capacity < Core::kMinSlots) {
+            throw std::invalid_argument("DynamicRingBuffer capacity must be at least " +
+                                        std::to_string(Core::kMinSlots) + " for its slot layout");
+        }
+        if (capacity > (std::numeric_limits<std::size_t>::max() - kBlockSize) / sizeof(slot_type)) {
+            throw std::length_error("DynamicRingBuffer capacity is too large");
+        }
+        return capacity;
+    }
+
+public:
+    using typename Core::value_type;
+    using typename Core::size_type;
+    /// The allocator type supplied by the user
+    using allocator_type = Allocator;
+
+    /**
+     * @brief Construct an empty ring buffer with the given number of slots
+     *
+     * Allocates storage for capacity slots. As with RingBuffer, the slots are
+     * left uninitialized until elements are pushed.
+     *
+     * @param capacity Number of slots (must be a power of 2 and greater than 1)
+     * @param allocator Allocator used for the slot storage
+     *
+     * @throws std::invalid_argument if capacity is not a power of 2 greater than 1,
+     *         or is below the minimum of Traits::Layout
+     * @throws std::length_error if the storage size would overflow
+     * @throws Whatever the allocator throws on allocation failure
+     */
+    explicit DynamicRingBuffer(size_type capacity, const Allocator& allocator = Allocator())
+        : index_mask_(validate_capacity(capacity) - 1),
+          block_count_((capacity * sizeof(slot_type) + kBlockSize - 1) / kBlockSize),
+          allocator_(allocator),
+          blocks_(BlockTraits::allocate(allocator_, block_count_)) {
+        slots_ = reinterpret_cast<slot_type*>(std::addressof(*blocks_));
+    }
+
+    /**
+     * @brief Destructor
+     *
+     * Destroys the elements still in the buffer and releases the storage.
+     * Must not run concurrently with producer or consumer operations.
+     */
+    ~DynamicRingBuffer() {
+        this->destroy_all();
+        BlockTraits::deallocate(allocator_, blocks_, block_count_);
+    }
+
+    /**
+     * @brief Get the maximum capacity
+     *
+     * @return The maximum number of elements this buffer can hold
+     *         (buffer_size() - 1, or buffer_size() with
+     *         RingBufferTraits::kFreeRunningIndices)
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return Traits::kFreeRunningIndices ? index_mask_ + 1 : index_mask_;
+    }
+
+    /**
+     * @brief Get the total buffer size
+     *
+     * @return The number of slots passed to the constructor
+     */
+    [[nodiscard]] size_type buffer_size() const noexcept {
+        return index_mask_ + 1;
+    }
+
+    /**
+     * @brief Get a copy of the allocator
+     */
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(allocator_);
+    }
+};
+
+} // namespace lockfree
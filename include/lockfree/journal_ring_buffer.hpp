@@ -0,0 +1,481 @@
+/**
+ * @file journal_ring_buffer.hpp
+ * @brief SPSC ring buffer whose entries live in a memory-mapped, segmented journal (POSIX)
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "mapped_region.hpp"
+#include "slot_layout.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lockfree {
+
+/**
+ * @brief Sizing and durability options for JournalRingBuffer
+ */
+struct JournalOptions {
+    /// Entries per segment file (power of 2); fixed when the journal is created
+    std::size_t segment_entries = 65536;
+
+    /// Maximum number of entries pushed but not yet popped
+    std::size_t capacity = 65536;
+
+    /// Pops between automatic commits; 0 commits only at segment ends and on commit()
+    std::size_t commit_every = 0;
+};
+
+namespace detail {
+
+/// Fixed-layout contents of a journal's meta file
+struct JournalHeader {
+    static constexpr std::uint64_t kMagic = 0x4C464A524E4C3031ULL;  // "LFJRNL01"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::atomic<std::uint64_t> magic;           ///< Stored last by the creator
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint32_t element_align;
+    std::uint32_t reserved;
+    std::uint64_t segment_entries;
+    std::atomic<std::uint64_t> committed_head;  ///< Where the consumer resumes after a restart
+
+    // Live indices, each on its own cache line. The literal 64 is part of the
+    // on-disk format and must not follow LOCKFREE_CACHE_LINE_SIZE
+    alignas(64) std::atomic<std::uint64_t> tail;
+    alignas(64) std::atomic<std::uint64_t> head;
+};
+
+} // namespace detail
+
+/**
+ * @brief SPSC ring buffer that doubles as an on-disk journal
+ *
+ * Entries are written straight into memory-mapped segment files in a
+ * directory, so the journal costs no copy beyond the push itself: the
+ * producer builds each entry in the file mapping and the consumer reads it
+ * from there. Segment n holds entries [n * segment_entries,
+ * (n + 1) * segment_entries) and is kept on disk after the consumer leaves
+ * it; only the segments holding unconsumed entries are mapped.
+ *
+ * The consumer commits its position by syncing the entries it popped since
+ * the last commit (msync) and then the committed head in the meta file.
+ * Commits happen on commit(), every JournalOptions::commit_every pops, and
+ * whenever the consumer finishes a segment, which also unmaps it. open() on
+ * an existing journal resumes from the committed head, so entries popped
+ * after the last commit are delivered again, and from the last published
+ * tail. A process crash loses nothing the producer published; after a power
+ * failure only committed entries are guaranteed on disk.
+ *
+ * The destructor does not commit; call commit() for a clean shutdown.
+ *
+ * Unlike SharedRingBuffer, both sides must be in the same process. push and
+ * pop may throw std::system_error when a segment has to be created, synced
+ * or mapped.
+ *
+ * @tparam T Element type (trivially copyable, so it can be stored as bytes)
+ *
+ * Example usage:
+ * @code
+ * lockfree::JournalOptions options;
+ * options.commit_every = 1024;
+ * auto journal = lockfree::JournalRingBuffer<Order>::open("/var/lib/feed/orders", options);
+ *
+ * // Producer thread
+ * journal.try_push(order);
+ *
+ * // Consumer thread: the order is on disk once its batch is committed
+ * if (auto order = journal.try_pop()) { ... }
+ * @endcode
+ */
+template <typename T>
+class JournalRingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "Journal entries must be trivially copyable");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "File-backed indices require lock-free atomics");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * @brief Open the journal in directory, creating it if needed
+     *
+     * An existing journal keeps its segment size; options.segment_entries is
+     * then ignored. Its capacity grows if more entries than
+     * options.capacity were left unconsumed.
+     *
+     * @throws std::invalid_argument if segment_entries is not a power of 2 or
+     *         capacity is zero
+     * @throws std::system_error if a file cannot be created, opened or mapped
+     * @throws std::runtime_error if the journal holds a different element
+     *         type or version, or a segment it needs is missing
+     */
+    static JournalRingBuffer open(const std::string& directory, const JournalOptions& options = {}) {
+        const auto segment_entries = options.segment_entries;
+        if (segment_entries == 0 || (segment_entries & (segment_entries - 1)) != 0) {
+            throw std::invalid_argument("JournalRingBuffer segment_entries must be a power of 2");
+        }
+        if (options.capacity == 0) {
+            throw std::invalid_argument("JournalRingBuffer capacity must be greater than 0");
+        }
+        if (::mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+            detail::throw_errno("mkdir " + directory);
+        }
+
+        JournalRingBuffer journal(directory, options);
+        journal.open_meta();
+        journal.recover();
+        return journal;
+    }
+
+    /**
+     * @brief Call fn(entry) for each consumed entry in [first, head)
+     *
+     * Reads the journal's sealed history, e.g. to rebuild state or serve a
+     * late subscriber. Safe to call while the journal is open elsewhere in
+     * the process, as consumed entries are never written again.
+     *
+     * @return The position after the last entry visited
+     *
+     * @throws std::system_error if the journal cannot be opened
+     * @throws std::runtime_error if it holds a different element type, or a
+     *         segment in the range was removed
+     */
+    template <typename F>
+    static std::uint64_t replay(const std::string& directory, std::uint64_t first, F&& fn) {
+        JournalRingBuffer journal(directory, JournalOptions{});
+        journal.open_meta(false);
+        const auto end = journal.header()->head.load(std::memory_order_acquire);
+        const auto mask = journal.segment_entries_ - 1;
+
+        std::uint64_t index = first;
+        while (index < end) {
+            const auto segment = index / journal.segment_entries_;
+            const auto region = journal.map_segment(segment, false);
+            const auto* entries = static_cast<const T*>(region.data());
+            const auto last = std::min<std::uint64_t>(end, (segment + 1) * journal.segment_entries_);
+            for (; index < last; ++index) {
+                fn(entries[index & mask]);
+            }
+        }
+        return index;
+    }
+
+    /**
+     * @brief Delete a journal's meta and segment files and its directory
+     *
+     * @return true if the directory existed and was removed
+     */
+    static bool remove(const std::string& directory) noexcept {
+        DIR* dir = ::opendir(directory.c_str());
+        if (dir == nullptr) {
+            return false;
+        }
+        while (const auto* item = ::readdir(dir)) {
+            const std::string file = item->d_name;
+            if (file == "journal.meta" || (file.size() > 4 && file.compare(file.size() - 4, 4, ".seg") == 0)) {
+                ::unlink((directory + "/" + file).c_str());
+            }
+        }
+        ::closedir(dir);
+        return ::rmdir(directory.c_str()) == 0;
+    }
+
+    JournalRingBuffer(JournalRingBuffer&&) noexcept = default;
+    JournalRingBuffer& operator=(JournalRingBuffer&&) noexcept = default;
+
+    /// Unmaps the journal without committing
+    ~JournalRingBuffer() = default;
+
+    /**
+     * @brief Attempt to append an element constructed from args
+     *
+     * @return true if there was room, false if capacity entries are unconsumed
+     *
+     * @throws std::system_error if the next segment file cannot be created
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        auto* ring = header();
+        const auto current_tail = ring->tail.load(std::memory_order_relaxed);
+        if (current_tail - cached_head_ >= capacity_) {
+            cached_head_ = ring->head.load(std::memory_order_acquire);
+            if (current_tail - cached_head_ >= capacity_) {
+                return false;
+            }
+        }
+
+        const auto segment = current_tail / segment_entries_;
+        if ((current_tail & (segment_entries_ - 1)) == 0) {
+            // The consumer released this table slot before publishing a
+            // head that makes room for the segment
+            segments_[segment % segments_.size()] = map_segment(segment, true);
+        }
+        ::new (entry(current_tail)) T(std::forward<Args>(args)...);
+        ring->tail.store(current_tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @copydoc try_emplace
+    [[nodiscard]] bool try_push(const T& item) {
+        return try_emplace(item);
+    }
+
+    /**
+     * @brief Attempt to take the oldest element
+     *
+     * Commits when the entry is the last of its segment or completes a batch
+     * of JournalOptions::commit_every pops.
+     *
+     * @return The element, or std::nullopt if the journal has no unconsumed entries
+     *
+     * @throws std::system_error if a commit fails; the element is then not
+     *         consumed and will be returned again
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] std::optional<T> try_pop() {
+        auto* ring = header();
+        const auto current_head = ring->head.load(std::memory_order_relaxed);
+        if (current_head == cached_tail_) {
+            cached_tail_ = ring->tail.load(std::memory_order_acquire);
+            if (current_head == cached_tail_) {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<T> item(*entry(current_head));
+        const auto new_head = current_head + 1;
+        if ((new_head & (segment_entries_ - 1)) == 0) {
+            commit_through(new_head);
+            segments_[(current_head / segment_entries_) % segments_.size()].reset();
+        } else if (commit_every_ != 0 && new_head - committed_ >= commit_every_) {
+            commit_through(new_head);
+        }
+        ring->head.store(new_head, std::memory_order_release);
+        return item;
+    }
+
+    /**
+     * @brief Make every popped entry and the consumer's position durable
+     *
+     * @throws std::system_error if msync() fails
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    void commit() {
+        commit_through(header()->head.load(std::memory_order_relaxed));
+    }
+
+    /// Journal position of the next entry to pop
+    [[nodiscard]] std::uint64_t head() const noexcept {
+        return header()->head.load(std::memory_order_acquire);
+    }
+
+    /// Journal position the next push writes
+    [[nodiscard]] std::uint64_t tail() const noexcept {
+        return header()->tail.load(std::memory_order_acquire);
+    }
+
+    /// Position a restart resumes from
+    [[nodiscard]] std::uint64_t committed_head() const noexcept {
+        return header()->committed_head.load(std::memory_order_acquire);
+    }
+
+    /// Number of unconsumed entries
+    [[nodiscard]] size_type size() const noexcept {
+        const auto current_head = head();
+        return static_cast<size_type>(tail() - current_head);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// Maximum number of unconsumed entries
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+    /// Entries per segment file
+    [[nodiscard]] size_type segment_entries() const noexcept { return segment_entries_; }
+
+    /// Directory holding the journal
+    [[nodiscard]] const std::string& directory() const noexcept { return directory_; }
+
+    /// Path of the file holding segment n
+    [[nodiscard]] std::string segment_path(std::uint64_t segment) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%016llx.seg", static_cast<unsigned long long>(segment));
+        return directory_ + name;
+    }
+
+private:
+    std::string directory_;
+    size_type segment_entries_;
+    size_type capacity_;
+    size_type commit_every_;
+    std::size_t page_size_;
+    detail::MappedRegion meta_;
+    std::vector<detail::MappedRegion> segments_;  ///< Mapped segment n at n % size()
+
+    // Producer-owned
+    alignas(detail::kCacheLineSize) std::uint64_t cached_head_ = 0;
+
+    // Consumer-owned
+    alignas(detail::kCacheLineSize) std::uint64_t cached_tail_ = 0;
+    std::uint64_t committed_ = 0;  ///< Entries before this are synced
+
+    JournalRingBuffer(std::string directory, const JournalOptions& options)
+        : directory_(std::move(directory)),
+          segment_entries_(options.segment_entries),
+          capacity_(options.capacity),
+          commit_every_(options.commit_every),
+          page_size_(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))) {}
+
+    [[nodiscard]] detail::JournalHeader* header() const noexcept {
+        return static_cast<detail::JournalHeader*>(meta_.data());
+    }
+
+    [[nodiscard]] T* entry(std::uint64_t index) const noexcept {
+        const auto& region = segments_[(index / segment_entries_) % segments_.size()];
+        return static_cast<T*>(region.data()) + (index & (segment_entries_ - 1));
+    }
+
+    [[nodiscard]] std::size_t segment_bytes() const noexcept {
+        return detail::round_up(segment_entries_ * sizeof(T), page_size_);
+    }
+
+    /// Map the meta file, creating and initializing it if create is set and it does not exist
+    void open_meta(bool create = true) {
+        const auto path = directory_ + "/journal.meta";
+        const std::size_t meta_size = detail::round_up(sizeof(detail::JournalHeader), page_size_);
+
+        detail::FileDescriptor fd(::open(path.c_str(), O_RDWR | (create ? O_CREAT : 0), 0600));
+        if (!fd) {
+            detail::throw_errno("open " + path);
+        }
+        if (create && fd.size() < meta_size && ::ftruncate(fd.get(), static_cast<off_t>(meta_size)) != 0) {
+            detail::throw_errno("ftruncate " + path);
+        }
+        if (fd.size() < meta_size) {
+            throw std::runtime_error("JournalRingBuffer " + directory_ + " is not initialized");
+        }
+        meta_ = detail::MappedRegion(fd, meta_size);
+
+        // A creator that died before storing the magic left nothing to recover
+        auto* ring = header();
+        if (create && ring->magic.load(std::memory_order_acquire) == 0) {
+            ::new (ring) detail::JournalHeader{};
+            ring->version = detail::JournalHeader::kVersion;
+            ring->element_size = static_cast<std::uint32_t>(sizeof(T));
+            ring->element_align = static_cast<std::uint32_t>(alignof(T));
+            ring->segment_entries = segment_entries_;
+            ring->magic.store(detail::JournalHeader::kMagic, std::memory_order_release);
+            sync(meta_.data(), meta_size);
+            return;
+        }
+
+        if (ring->magic.load(std::memory_order_acquire) != detail::JournalHeader::kMagic) {
+            throw std::runtime_error("JournalRingBuffer " + directory_ + " is not initialized");
+        }
+        if (ring->version != detail::JournalHeader::kVersion) {
+            throw std::runtime_error("JournalRingBuffer " + directory_ + " has an incompatible layout version");
+        }
+        if (ring->element_size != sizeof(T) || ring->element_align != alignof(T)) {
+            throw std::runtime_error("JournalRingBuffer " + directory_ + " holds a different element type");
+        }
+        const auto stored_segment = ring->segment_entries;
+        if (stored_segment == 0 || (stored_segment & (stored_segment - 1)) != 0) {
+            throw std::runtime_error("JournalRingBuffer " + directory_ + " has an inconsistent header");
+        }
+        segment_entries_ = static_cast<size_type>(stored_segment);
+    }
+
+    /// Rewind to the committed head and map the segments holding unconsumed entries
+    void recover() {
+        auto* ring = header();
+        const auto head = ring->committed_head.load(std::memory_order_relaxed);
+        const auto tail = ring->tail.load(std::memory_order_relaxed);
+        if (tail < head) {
+            throw std::runtime_error("JournalRingBuffer " + directory_ + " has an inconsistent header");
+        }
+        if (tail - head > capacity_) {
+            capacity_ = static_cast<size_type>(tail - head);
+        }
+        ring->head.store(head, std::memory_order_relaxed);
+        cached_head_ = head;
+        cached_tail_ = head;
+        committed_ = head;
+
+        segments_.resize((capacity_ + segment_entries_ - 1) / segment_entries_ + 2);
+        const auto first = head / segment_entries_;
+        const auto end = (tail + segment_entries_ - 1) / segment_entries_;
+        for (auto segment = first; segment < end; ++segment) {
+            segments_[segment % segments_.size()] = map_segment(segment, false);
+        }
+    }
+
+    /// Map segment n, creating its file if create is set
+    [[nodiscard]] detail::MappedRegion map_segment(std::uint64_t segment, bool create) const {
+        const auto path = segment_path(segment);
+        detail::FileDescriptor fd(::open(path.c_str(), O_RDWR | (create ? O_CREAT : 0), 0600));
+        if (!fd) {
+            if (!create && errno == ENOENT) {
+                throw std::runtime_error("JournalRingBuffer segment " + path + " is missing");
+            }
+            detail::throw_errno("open " + path);
+        }
+        const auto bytes = segment_bytes();
+        if (fd.size() < bytes && ::ftruncate(fd.get(), static_cast<off_t>(bytes)) != 0) {
+            detail::throw_errno("ftruncate " + path);
+        }
+        return detail::MappedRegion(fd, bytes);
+    }
+
+    /// Sync the entries popped before position, then record position as committed
+    void commit_through(std::uint64_t position) {
+        if (position == committed_) {
+            return;
+        }
+        // Segment ends always commit, so the range lies in one mapped segment
+        const auto offset = (committed_ & (segment_entries_ - 1)) * sizeof(T);
+        const auto length = static_cast<std::size_t>(position - committed_) * sizeof(T);
+        auto* base = static_cast<unsigned char*>(
+            segments_[(committed_ / segment_entries_) % segments_.size()].data());
+        const auto page_offset = offset / page_size_ * page_size_;
+        sync(base + page_offset, offset + length - page_offset);
+
+        header()->committed_head.store(position, std::memory_order_release);
+        sync(meta_.data(), meta_.size());
+        committed_ = position;
+    }
+
+    static void sync(void* address, std::size_t length) {
+        if (::msync(address, length, MS_SYNC) != 0) {
+            detail::throw_errno("msync");
+        }
+    }
+};
+
+} // namespace lockfree
@@ -0,0 +1,124 @@
+/**
+ * @file lazy_consumer.hpp
+ * @brief Consumer handle that hands slots back to the producer in batches
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+
+/**
+ * @brief Consumer handle that publishes the ring's head once per batch
+ *
+ * The mirror of WriteCombiningProducer. Every try_pop() on a ring stores the
+ * head, so the producer's full check keeps pulling a freshly dirtied line.
+ * Popping through this handle moves each element out right away but
+ * publishes the head only once batch elements are taken, when the ring is
+ * seen empty, or on flush(). Publishing on empty keeps the producer from
+ * stalling on slots the consumer has finished with; combined with cached
+ * indices, a deep queue then costs close to no coherence traffic per element.
+ *
+ * Until then, popped slots stay unavailable to the producer and hold
+ * moved-from elements, which are destroyed when the head is published. The
+ * destructor flushes.
+ *
+ * Works with RingBuffer, DynamicRingBuffer and SharedRingBuffer, and any
+ * slot layout. While the handle exists, every pop must go through it.
+ *
+ * @tparam Ring Ring buffer type
+ *
+ * Example usage:
+ * @code
+ * lockfree::RingBuffer<Packet, 4096> packets;
+ * lockfree::LazyConsumer<decltype(packets)> consumer(packets, 32);
+ *
+ * while (running) {
+ *     if (auto packet = consumer.try_pop()) {
+ *         process(*packet);
+ *     }
+ * }
+ * @endcode
+ */
+template <typename Ring>
+class LazyConsumer {
+public:
+    using ring_type = Ring;
+    using value_type = typename Ring::value_type;
+    using size_type = typename Ring::size_type;
+
+private:
+    Ring& ring_;
+    size_type batch_;
+    size_type taken_ = 0;  ///< Popped elements whose slots are not yet released
+
+public:
+    /**
+     * @brief Create a handle popping from ring
+     *
+     * @param ring Ring to pop from; must outlive the handle
+     * @param batch Publish the head once this many elements are taken
+     *
+     * @throws std::invalid_argument if batch is zero or exceeds ring.capacity()
+     */
+    LazyConsumer(Ring& ring, size_type batch) : ring_(ring), batch_(batch) {
+        if (batch == 0 || batch > ring.capacity()) {
+            throw std::invalid_argument("LazyConsumer batch must be between 1 and the ring capacity");
+        }
+    }
+
+    /// Releases the slots of the elements taken so far
+    ~LazyConsumer() {
+        flush();
+    }
+
+    LazyConsumer(const LazyConsumer&) = delete;
+    LazyConsumer& operator=(const LazyConsumer&) = delete;
+
+    /**
+     * @brief Remove the oldest element, publishing the head if a threshold is hit
+     *
+     * @return The element, or std::nullopt if the ring is empty; the slots
+     *         taken so far are then handed back to the producer
+     */
+    [[nodiscard]] std::optional<value_type> try_pop() noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+        value_type* slot = ring_.try_acquire(taken_);
+        if (slot == nullptr) {
+            flush();
+            return std::nullopt;
+        }
+        std::optional<value_type> item(std::move(*slot));
+        if (++taken_ == batch_) {
+            flush();
+        }
+        return item;
+    }
+
+    /// Hand every taken slot back to the producer
+    void flush() noexcept {
+        if (taken_ != 0) {
+            ring_.release(taken_);
+            taken_ = 0;
+        }
+    }
+
+    /// Number of elements popped whose slots are not yet released
+    [[nodiscard]] size_type taken() const noexcept {
+        return taken_;
+    }
+
+    /// Elements taken per publish
+    [[nodiscard]] size_type batch() const noexcept {
+        return batch_;
+    }
+};
+
+} // namespace lockfree
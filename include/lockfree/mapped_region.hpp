@@ -0,0 +1,139 @@
+/**
+ * @file mapped_region.hpp
+ * @brief RAII wrappers for file descriptors and shared memory mappings (POSIX)
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+namespace lockfree {
+namespace detail {
+
+[[noreturn]] inline void throw_errno(const std::string& what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+[[nodiscard]] constexpr std::size_t round_up(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Owning file descriptor, closed on destruction
+ */
+class FileDescriptor {
+    int fd_ = -1;
+
+public:
+    FileDescriptor() noexcept = default;
+    explicit FileDescriptor(int fd) noexcept : fd_(fd) {}
+
+    FileDescriptor(FileDescriptor&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+    FileDescriptor& operator=(FileDescriptor&& other) noexcept {
+        if (this != &other) {
+            reset();
+            fd_ = std::exchange(other.fd_, -1);
+        }
+        return *this;
+    }
+
+    ~FileDescriptor() { reset(); }
+
+    void reset() noexcept {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    [[nodiscard]] int get() const noexcept { return fd_; }
+    [[nodiscard]] explicit operator bool() const noexcept { return fd_ >= 0; }
+
+    /// Current size of the file in bytes
+    [[nodiscard]] std::size_t size() const {
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0) {
+            throw_errno("fstat");
+        }
+        return static_cast<std::size_t>(info.st_size);
+    }
+
+    /**
+     * @brief Granularity the file can be mapped and sized in
+     *
+     * The page size, or the filesystem block size if larger; on hugetlbfs
+     * that is the huge page size, which ftruncate() and mmap() require.
+     */
+    [[nodiscard]] std::size_t mapping_granularity() const {
+        auto granularity = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        struct statvfs fs {};
+        if (::fstatvfs(fd_, &fs) == 0 && fs.f_bsize > granularity) {
+            granularity = static_cast<std::size_t>(fs.f_bsize);
+        }
+        return granularity;
+    }
+};
+
+/**
+ * @brief Shared read-write mapping of a file, unmapped on destruction
+ */
+class MappedRegion {
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    MappedRegion() noexcept = default;
+
+    /**
+     * @brief Map the first size bytes of fd with MAP_SHARED
+     *
+     * @throws std::system_error if mmap() fails
+     */
+    MappedRegion(const FileDescriptor& fd, std::size_t size, int extra_flags = 0) : size_(size) {
+        data_ = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | extra_flags, fd.get(), 0);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            throw_errno("mmap");
+        }
+    }
+
+    MappedRegion(MappedRegion&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+    MappedRegion& operator=(MappedRegion&& other) noexcept {
+        if (this != &other) {
+            reset();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedRegion() { reset(); }
+
+    void reset() noexcept {
+        if (data_) {
+            ::munmap(data_, size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    [[nodiscard]] void* data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+};
+
+} // namespace detail
+} // namespace lockfree
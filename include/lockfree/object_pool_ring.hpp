@@ -0,0 +1,241 @@
+/**
+ * @file object_pool_ring.hpp
+ * @brief SPSC message ring that recycles its objects through a paired return ring
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lockfree {
+
+/**
+ * @brief SPSC ring of pooled objects that are handed back for reuse
+ *
+ * Messages that own heap buffers (a std::vector<char> payload, a
+ * std::string) normally cost a malloc on the producer and a cross-thread
+ * free on the consumer. Here a fixed pool of objects is built once, and
+ * only pointers move: the producer takes a free object, fills it and
+ * publishes it on the message ring; the consumer reads it and recycles it
+ * onto a second ring running the other way. A recycled object keeps its
+ * state, so its buffers keep their capacity and the steady state allocates
+ * nothing.
+ *
+ * Both rings hold pool_size() pointers, which is every object, so publish()
+ * and recycle() never fail; an exhausted pool is the backpressure instead
+ * (try_acquire() returns nullptr until the consumer recycles).
+ *
+ * Every acquired object must be published and every received one
+ * recycled, by the thread that got it. A producer that decides not to send
+ * keeps the object for its next message.
+ *
+ * @tparam T Pooled object type (default constructible)
+ * @tparam Capacity Slots per ring (power of 2), as for RingBuffer
+ * @tparam Traits Tuning options for both rings; WaitPolicy is used by
+ *         acquire() and receive()
+ *
+ * Example usage:
+ * @code
+ * lockfree::ObjectPoolRing<Packet, 1024> packets([](Packet& p) { p.payload.reserve(1500); });
+ *
+ * // Producer thread
+ * if (Packet* p = packets.try_acquire()) {
+ *     p->payload.assign(frame, frame + length);   // reuses the old capacity
+ *     packets.publish(p);
+ * }
+ *
+ * // Consumer thread
+ * if (Packet* p = packets.try_receive()) {
+ *     handle(*p);
+ *     packets.recycle(p);
+ * }
+ * @endcode
+ */
+template <typename T, std::size_t Capacity, typename Traits = RingBufferTraits>
+class ObjectPoolRing {
+    static_assert(std::is_default_constructible_v<T>, "Pooled objects must be default constructible");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+private:
+    using Ring = RingBuffer<T*, Capacity, Traits>;
+
+    Ring messages_;         ///< Producer to consumer
+    Ring returns_;          ///< Consumer to producer
+    std::vector<T> pool_;   ///< Owns every object; never resized
+    T* spare_ = nullptr;    ///< Producer-owned: kept when a fill throws
+
+public:
+    /// Build a pool of default-constructed objects
+    ObjectPoolRing() : ObjectPoolRing([](T&) {}) {}
+
+    /**
+     * @brief Build the pool, calling init on each object first
+     *
+     * @param init Callable taking T&, e.g. to reserve buffer capacity up front
+     */
+    template <typename Init, typename = std::enable_if_t<std::is_invocable_v<Init&, T&>>>
+    explicit ObjectPoolRing(Init&& init) : pool_(messages_.capacity()) {
+        for (T& object : pool_) {
+            init(object);
+            (void)returns_.try_push(&object);
+        }
+    }
+
+    ObjectPoolRing(const ObjectPoolRing&) = delete;
+    ObjectPoolRing& operator=(const ObjectPoolRing&) = delete;
+
+    /**
+     * @brief Take a free object to fill
+     *
+     * @return The object, or nullptr if every object is in flight
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] T* try_acquire() noexcept {
+        if (spare_ != nullptr) {
+            return std::exchange(spare_, nullptr);
+        }
+        T* object = nullptr;
+        return returns_.try_pop(object) ? object : nullptr;
+    }
+
+    /**
+     * @brief Take a free object, waiting for the consumer to recycle one
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] T* acquire() {
+        if (spare_ != nullptr) {
+            return std::exchange(spare_, nullptr);
+        }
+        return returns_.pop();
+    }
+
+    /**
+     * @brief Send an object returned by try_acquire() or acquire()
+     *
+     * @note This function should only be called from the producer thread
+     */
+    void publish(T* object) noexcept {
+        (void)messages_.try_push(object);
+    }
+
+    /**
+     * @brief Acquire, fill and publish in one call
+     *
+     * @param fill Callable taking T& that writes the message; if it throws,
+     *        the object is kept for the next acquire
+     * @return false (without calling fill) if every object is in flight
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename F>
+    [[nodiscard]] bool try_publish(F&& fill) {
+        T* object = try_acquire();
+        if (object == nullptr) {
+            return false;
+        }
+        try {
+            fill(*object);
+        } catch (...) {
+            spare_ = object;
+            throw;
+        }
+        publish(object);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest published object
+     *
+     * @return The object, or nullptr if nothing was published
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] T* try_receive() noexcept {
+        T* object = nullptr;
+        return messages_.try_pop(object) ? object : nullptr;
+    }
+
+    /**
+     * @brief Take the oldest published object, waiting for one
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] T* receive() {
+        return messages_.pop();
+    }
+
+    /**
+     * @brief Hand an object returned by try_receive() or receive() back to the producer
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    void recycle(T* object) noexcept {
+        (void)returns_.try_push(object);
+    }
+
+    /**
+     * @brief Receive, process and recycle in one call
+     *
+     * @param fn Callable taking T&; the object is recycled after it returns
+     *        or throws
+     * @return false (without calling fn) if nothing was published
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    template <typename F>
+    [[nodiscard]] bool try_consume(F&& fn) {
+        T* object = try_receive();
+        if (object == nullptr) {
+            return false;
+        }
+        try {
+            fn(*object);
+        } catch (...) {
+            recycle(object);
+            throw;
+        }
+        recycle(object);
+        return true;
+    }
+
+    /// Number of pooled objects
+    [[nodiscard]] size_type pool_size() const noexcept {
+        return pool_.size();
+    }
+
+    /// Number of published objects not yet received
+    [[nodiscard]] size_type size() const noexcept {
+        return messages_.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return messages_.empty();
+    }
+
+    /// Number of objects free for the producer (approximate across threads)
+    [[nodiscard]] size_type available() const noexcept {
+        return returns_.size();
+    }
+
+    /// Whether object belongs to this pool
+    [[nodiscard]] bool owns(const T* object) const noexcept {
+        const std::less<const T*> before;
+        return !pool_.empty() && !before(object, pool_.data()) && before(object, pool_.data() + pool_.size());
+    }
+};
+
+} // namespace lockfree
@@ -0,0 +1,251 @@
+/**
+ * @file overwrite_ring_buffer.hpp
+ * @brief SPSC ring buffer whose producer overwrites the oldest data instead of failing
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+#include "seqlock.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+
+/**
+ * @brief Lossy SPSC ring buffer for telemetry and snapshot feeds
+ *
+ * The producer never blocks and never fails: when the consumer has fallen a
+ * full lap behind, the next push overwrites the oldest slot. The producer's
+ * cost per push is therefore bounded whatever the consumer does; it never
+ * even reads the consumer's index.
+ *
+ * Every slot carries a version (seqlock-style) that the consumer checks around
+ * its copy, so it never returns a torn element. When the consumer finds it has
+ * been lapped, it discards everything older than the newest element, which is
+ * the one a stale-data-tolerant consumer wants, and adds the elements it lost
+ * to dropped().
+ *
+ * @tparam T Type of elements stored in the buffer (must be trivially copyable,
+ *         since the consumer may copy a slot while it is being overwritten)
+ * @tparam Capacity Number of slots (must be a power of 2); all are usable
+ * @tparam Traits Tuning knobs; only WaitPolicy is used (by pop()) and it must
+ *         be a spinning policy (not SpinSleepWait)
+ *
+ * Example usage:
+ * @code
+ * lockfree::OverwriteRingBuffer<TopOfBook, 1024> snapshots;
+ *
+ * // Feed handler: never stalls on a slow consumer
+ * snapshots.push(book);
+ *
+ * // Strategy: only cares about the freshest state
+ * if (auto book = snapshots.try_pop_latest()) { reprice(*book); }
+ * @endcode
+ */
+template <typename T, std::size_t Capacity, typename Traits = RingBufferTraits>
+class OverwriteRingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 1,
+                  "Capacity must be a power of 2 and greater than 1");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Overwriting rings copy slots that may be overwritten, so T must be trivially copyable");
+    static_assert(std::is_empty_v<typename Traits::WaitPolicy::State>,
+                  "Overwriting rings support spinning wait policies only (not SpinSleepWait)");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+private:
+    static constexpr size_type kIndexMask = Capacity - 1;
+
+    using WaitPolicy = typename Traits::WaitPolicy;
+    using Cell = detail::VersionedSlot<T>;
+
+    alignas(detail::kCacheLineSize) std::atomic<size_type> tail_{0};  ///< Next position to write
+    alignas(detail::kCacheLineSize) std::atomic<size_type> head_{0};  ///< Next position to read
+    size_type tail_cache_{0};  ///< Consumer's copy of tail_
+    size_type dropped_{0};     ///< Elements lost to being lapped, see dropped()
+    alignas(detail::kCacheLineSize) Cell cells_[Capacity];
+
+    [[nodiscard]] Cell& cell(size_type position) noexcept {
+        return cells_[position & kIndexMask];
+    }
+
+    /**
+     * Copy out the element at head, or the newest one if head has been
+     * overwritten. tail_cache_ must be ahead of head. A lap counts the
+     * elements skipped in dropped_, or with newest_only only those that were
+     * overwritten, since the rest would have been skipped anyway.
+     */
+    [[nodiscard]] T read_from(size_type head, bool newest_only) noexcept {
+        // More than a lap behind: head's slot already holds a later element
+        bool lapped = tail_cache_ - head > Capacity;
+        while (true) {
+            if (lapped || newest_only) {
+                const auto newest = tail_cache_ - 1;
+                if (lapped) {
+                    if (!newest_only) {
+                        dropped_ += newest - head;
+                    } else if (tail_cache_ - head > Capacity) {
+                        dropped_ += tail_cache_ - head - Capacity;
+                    }
+                }
+                head = newest;
+            }
+            detail::Slot<T> copy;
+            if (cell(head).load(head, copy)) {
+                head_.store(head + 1, std::memory_order_relaxed);
+                return Cell::element(copy);
+            }
+            // The producer has started on the slot a lap later
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            lapped = true;
+        }
+    }
+
+public:
+    /**
+     * @brief Default constructor
+     *
+     * The element storage is left uninitialized.
+     */
+    OverwriteRingBuffer() noexcept {}
+
+    OverwriteRingBuffer(const OverwriteRingBuffer&) = delete;
+    OverwriteRingBuffer& operator=(const OverwriteRingBuffer&) = delete;
+    OverwriteRingBuffer(OverwriteRingBuffer&&) = delete;
+    OverwriteRingBuffer& operator=(OverwriteRingBuffer&&) = delete;
+
+    /**
+     * @brief Construct an element in place, overwriting the oldest if full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename... Args>
+    void emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        cell(tail).store(tail, std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Add an element, overwriting the oldest if full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    void push(const T& item) noexcept {
+        emplace(item);
+    }
+
+    /**
+     * @brief Remove the oldest element still available
+     *
+     * If the producer has lapped the consumer, this returns the newest
+     * element instead and counts every element skipped, overwritten or not,
+     * in dropped().
+     *
+     * @return The element, or std::nullopt if there is nothing new
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] std::optional<T> try_pop() noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return std::nullopt;
+            }
+        }
+        return read_from(head, false);
+    }
+
+    /**
+     * @brief Remove everything available and return only the newest element
+     *
+     * The older elements passed over are discarded deliberately and are not
+     * counted in dropped(). If the producer has lapped the consumer, the
+     * elements that were overwritten before this call are counted.
+     *
+     * @return The newest element, or std::nullopt if there is nothing new
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] std::optional<T> try_pop_latest() noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        tail_cache_ = tail_.load(std::memory_order_acquire);
+        if (head == tail_cache_) {
+            return std::nullopt;
+        }
+        return read_from(head, true);
+    }
+
+    /**
+     * @brief Remove the oldest element still available, waiting for one
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] T pop() {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            typename WaitPolicy::State state;
+            WaitPolicy::wait(state, [&] {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                return head != tail_cache_;
+            }, detail::NoDeadline{});
+        }
+        return read_from(head, false);
+    }
+
+    /**
+     * @brief Get the number of elements lost because the producer lapped
+     *        the consumer
+     *
+     * A lapped try_pop() or pop() counts everything it skips to reach the
+     * newest element; a lapped try_pop_latest() counts only the elements
+     * that were overwritten.
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] size_type dropped() const noexcept {
+        return dropped_;
+    }
+
+    /**
+     * @brief Check if the buffer appears empty
+     *
+     * @note This is an approximate check. The state may change immediately
+     *       after this function returns due to concurrent operations.
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the approximate number of unread elements still held
+     *
+     * @note This is an approximate value, at most Capacity.
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        return std::min(tail - head, Capacity);
+    }
+
+    /**
+     * @brief Get the number of elements held before the oldest is overwritten
+     */
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return Capacity;
+    }
+};
+
+} // namespace lockfree
@@ -0,0 +1,249 @@
+/**
+ * @file page_allocator.hpp
+ * @brief Huge-page, NUMA-bound, prefaulted and locked storage for large rings (POSIX)
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "mapped_region.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+namespace lockfree {
+
+/**
+ * @brief Where and how the pages behind a ring's storage are placed
+ *
+ * Large rings touch more pages than the TLB covers and take their first
+ * page faults on the hot path. Huge pages cut the TLB misses, binding to the
+ * consumer's NUMA node keeps its reads local, and prefaulting plus locking
+ * moves every fault to construction time.
+ *
+ * huge_pages is a best-effort hint; numa_node and lock either take effect or
+ * make the allocation throw.
+ */
+struct MemoryPlacement {
+    /// Back with huge pages: MAP_HUGETLB if pages are reserved, else MADV_HUGEPAGE
+    bool huge_pages = false;
+    /// Bind the pages to this NUMA node (-1 leaves placement to the kernel)
+    int numa_node = -1;
+    /// Fault every page in at construction (MADV_POPULATE_WRITE or touching)
+    bool prefault = false;
+    /// mlock() the pages, subject to RLIMIT_MEMLOCK
+    bool lock = false;
+};
+
+/**
+ * @brief NUMA node of the CPU the calling thread is running on
+ *
+ * Call it from the consumer thread (pinned, ideally) to find the node its
+ * ring should be bound to.
+ *
+ * @return The node, or -1 if it cannot be determined on this platform
+ */
+[[nodiscard]] inline int current_numa_node() noexcept {
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+        return static_cast<int>(node);
+    }
+#endif
+    return -1;
+}
+
+namespace detail {
+
+/// Huge page size assumed for MAP_HUGETLB (the default on x86-64 and 4K-page arm64)
+inline constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+/// Highest NUMA node count accepted by bind_to_node()
+inline constexpr int kMaxNumaNodes = 1024;
+
+[[nodiscard]] inline std::size_t page_size() noexcept {
+    static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+/// Bind [data, data + size) to node, migrating any pages already faulted in
+inline void bind_to_node(void* data, std::size_t size, int node) {
+    if (node < 0 || node >= kMaxNumaNodes) {
+        throw std::invalid_argument("NUMA node " + std::to_string(node) + " is out of range");
+    }
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr std::size_t kBits = std::numeric_limits<unsigned long>::digits;
+    unsigned long mask[kMaxNumaNodes / kBits] = {};
+    mask[static_cast<std::size_t>(node) / kBits] = 1UL << (static_cast<std::size_t>(node) % kBits);
+    // The kernel ignores the last bit of maxnode, hence the + 1
+    if (::syscall(SYS_mbind, data, size, MPOL_BIND, mask, kMaxNumaNodes + 1, MPOL_MF_MOVE) != 0) {
+        throw_errno("mbind to node " + std::to_string(node));
+    }
+#else
+    (void)data;
+    (void)size;
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                            "NUMA binding is not supported on this platform");
+#endif
+}
+
+/**
+ * Make every page of [data, data + size) present and writable. The fallback
+ * touches each page with an atomic add of zero, which leaves live data in a
+ * shared mapping intact.
+ */
+inline void prefault_pages(void* data, std::size_t size) noexcept {
+#if defined(MADV_POPULATE_WRITE)
+    if (::madvise(data, size, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    auto* bytes = static_cast<unsigned char*>(data);
+    for (std::size_t offset = 0; offset < size; offset += page_size()) {
+        __atomic_fetch_add(bytes + offset, 0, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * Apply placement to a fresh page-aligned mapping, before anything is
+ * constructed in it. advise_huge asks for transparent huge pages; it is false
+ * when the mapping already uses MAP_HUGETLB.
+ */
+inline void apply_placement(void* data, std::size_t size, const MemoryPlacement& placement, bool advise_huge) {
+#if defined(MADV_HUGEPAGE)
+    if (placement.huge_pages && advise_huge) {
+        // Only a hint: fails harmlessly where THP is compiled out or the mapping is hugetlbfs
+        ::madvise(data, size, MADV_HUGEPAGE);
+    }
+#else
+    (void)advise_huge;
+#endif
+    if (placement.numa_node != -1) {
+        bind_to_node(data, size, placement.numa_node);
+    }
+    if (placement.prefault) {
+        prefault_pages(data, size);
+    }
+    if (placement.lock && ::mlock(data, size) != 0) {
+        throw_errno("mlock");
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Allocator that maps its storage directly, placed per MemoryPlacement
+ *
+ * Every allocation is its own anonymous mmap(), rounded up to the page size
+ * (or the huge page size when huge_pages is set), so it suits a few large,
+ * long-lived blocks such as ring storage, not general use. Plug it into
+ * DynamicRingBuffer, which rebinds it to its storage block type.
+ *
+ * @tparam T Element type
+ *
+ * Example usage:
+ * @code
+ * lockfree::MemoryPlacement placement;
+ * placement.huge_pages = true;
+ * placement.numa_node = consumer_node;  // lockfree::current_numa_node() on the consumer
+ * placement.prefault = true;
+ * placement.lock = true;
+ *
+ * lockfree::DynamicRingBuffer<Order, lockfree::PageAllocator<Order>> orders(
+ *     1 << 20, lockfree::PageAllocator<Order>(placement));
+ * @endcode
+ */
+template <typename T>
+class PageAllocator {
+    MemoryPlacement placement_;
+
+    [[nodiscard]] std::size_t mapping_size(std::size_t n) const noexcept {
+        return detail::round_up(n * sizeof(T), placement_.huge_pages ? detail::kHugePageSize : detail::page_size());
+    }
+
+public:
+    using value_type = T;
+    using is_always_equal = std::false_type;
+
+    PageAllocator() noexcept = default;
+
+    explicit PageAllocator(const MemoryPlacement& placement) noexcept : placement_(placement) {}
+
+    template <typename U>
+    PageAllocator(const PageAllocator<U>& other) noexcept : placement_(other.placement()) {}
+
+    /**
+     * @brief Map storage for n elements and apply the placement
+     *
+     * @throws std::bad_alloc if the mapping fails
+     * @throws std::invalid_argument if numa_node is out of range
+     * @throws std::system_error if NUMA binding or mlock() fails
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n > (std::numeric_limits<std::size_t>::max() - detail::kHugePageSize) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const auto size = mapping_size(n);
+        void* data = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+        if (placement_.huge_pages) {
+            // Fails unless huge pages are reserved (vm.nr_hugepages)
+            data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        const bool hugetlb = data != MAP_FAILED;
+        if (!hugetlb) {
+            data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (data == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+        }
+        try {
+            detail::apply_placement(data, size, placement_, !hugetlb);
+        } catch (...) {
+            ::munmap(data, size);
+            throw;
+        }
+        return static_cast<T*>(data);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        ::munmap(p, mapping_size(n));
+    }
+
+    [[nodiscard]] const MemoryPlacement& placement() const noexcept {
+        return placement_;
+    }
+};
+
+template <typename T, typename U>
+[[nodiscard]] bool operator==(const PageAllocator<T>& lhs, const PageAllocator<U>& rhs) noexcept {
+    const auto& a = lhs.placement();
+    const auto& b = rhs.placement();
+    return a.huge_pages == b.huge_pages && a.numa_node == b.numa_node && a.prefault == b.prefault &&
+           a.lock == b.lock;
+}
+
+template <typename T, typename U>
+[[nodiscard]] bool operator!=(const PageAllocator<T>& lhs, const PageAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+} // namespace lockfree
@@ -0,0 +1,532 @@
+/**
+ * @file pipeline.hpp
+ * @brief Linear pipelines of stages on their own threads, linked by SPSC rings
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "lazy_consumer.hpp"
+#include "ring_buffer.hpp"
+#include "ring_stats.hpp"
+#include "write_combining_producer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace lockfree {
+
+/// Per-stage options for PipelineBuilder::stage() and sink()
+struct StageOptions {
+    /// CPU to pin the stage's thread to (-1 leaves placement to the scheduler)
+    int cpu = -1;
+    /// Elements handed on per index publish on the stage's rings (at most their capacity)
+    std::size_t batch = 32;
+};
+
+/**
+ * @brief Snapshot of one stage's counters, returned by Pipeline::stats()
+ *
+ * A bottleneck stage shows a full input ring, while the stage before it
+ * shows full_stalls rising and the stage after it idle_polls rising.
+ */
+struct PipelineStageStats {
+    std::string name;
+    std::uint64_t processed = 0;    ///< Elements the stage has handled
+    std::uint64_t idle_polls = 0;   ///< Polls that found the input ring empty
+    std::uint64_t full_stalls = 0;  ///< Retries because the output ring was full
+    std::size_t input_size = 0;     ///< Approximate occupancy of the input ring
+    std::size_t input_capacity = 0;
+};
+
+namespace detail {
+
+/// Shutdown and failure state shared by all stages of a pipeline
+struct PipelineControl {
+    std::atomic<bool> cancelled{false};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    /// Record the first stage failure and stop every stage
+    void fail(std::exception_ptr failure) noexcept {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::move(failure);
+            }
+        }
+        cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] bool is_cancelled() const noexcept {
+        return cancelled.load(std::memory_order_relaxed);
+    }
+};
+
+/// Pin thread to cpu
+inline void pin_thread(std::thread& thread, int cpu) {
+#if defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        throw std::invalid_argument("CPU " + std::to_string(cpu) + " is out of range");
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (const int error = ::pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set)) {
+        throw std::system_error(error, std::generic_category(), "pin stage thread to CPU " + std::to_string(cpu));
+    }
+#else
+    (void)thread;
+    (void)cpu;
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported),
+                            "Thread pinning is not supported on this platform");
+#endif
+}
+
+/// Backs off a stage thread that found nothing to do
+class StageBackoff {
+    static constexpr int kSpinCount = 64;
+    int idle_ = 0;
+
+public:
+    void reset() noexcept {
+        idle_ = 0;
+    }
+
+    void pause() noexcept {
+        if (idle_ < kSpinCount) {
+            ++idle_;
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+/// Type-erased stage, run by its own thread
+class PipelineStageBase {
+public:
+    PipelineStageBase(std::string name, const StageOptions& options)
+        : name_(std::move(name)), options_(options) {}
+    virtual ~PipelineStageBase() = default;
+
+    PipelineStageBase(const PipelineStageBase&) = delete;
+    PipelineStageBase& operator=(const PipelineStageBase&) = delete;
+
+    /// Thread body: handle elements until the input is drained or the pipeline is cancelled
+    virtual void run(PipelineControl& control) = 0;
+
+    [[nodiscard]] virtual PipelineStageStats stats() const = 0;
+
+    [[nodiscard]] const StageOptions& options() const noexcept {
+        return options_;
+    }
+
+    /// Set once the stage has published its last output
+    std::atomic<bool> done{false};
+
+protected:
+    std::string name_;
+    StageOptions options_;
+    OwnedCounter processed_;
+    OwnedCounter idle_polls_;
+    OwnedCounter full_stalls_;
+
+    template <typename Ring>
+    [[nodiscard]] PipelineStageStats make_stats(const Ring& input) const {
+        PipelineStageStats result;
+        result.name = name_;
+        result.processed = processed_.get();
+        result.idle_polls = idle_polls_.get();
+        result.full_stalls = full_stalls_.get();
+        result.input_size = input.size();
+        result.input_capacity = Ring::capacity();
+        return result;
+    }
+};
+
+/**
+ * Stage reading In from its input ring and, unless Out is void, writing the
+ * results to the output ring it owns. A sink (Out = void) only consumes.
+ */
+template <typename In, typename Out, typename F, std::size_t Capacity, typename Traits>
+class PipelineStage final : public PipelineStageBase {
+    using input_ring = RingBuffer<In, Capacity, Traits>;
+    using output_ring = RingBuffer<std::conditional_t<std::is_void_v<Out>, char, Out>, Capacity, Traits>;
+
+    input_ring& input_;
+    const std::atomic<bool>& upstream_done_;
+    std::unique_ptr<output_ring> output_;  ///< Null for a sink
+    F fn_;
+
+    /// Hand one element on, waiting while the output ring is full
+    template <typename Producer, typename Value>
+    void emit(Producer& producer, Value&& value, PipelineControl& control) {
+        while (!producer.try_push(std::forward<Value>(value))) {
+            if (control.is_cancelled()) {
+                return;
+            }
+            full_stalls_.add(1);
+            std::this_thread::yield();
+        }
+    }
+
+    template <typename Handle, typename Flush>
+    void run_loop(PipelineControl& control, Handle&& handle, Flush&& flush) {
+        LazyConsumer<input_ring> consumer(input_, options_.batch);
+        StageBackoff backoff;
+        while (!control.is_cancelled()) {
+            if (auto item = consumer.try_pop()) {
+                handle(std::move(*item));
+                processed_.add(1);
+                backoff.reset();
+                continue;
+            }
+            // The empty pop released the input slots; make our output visible too
+            flush();
+            // The upstream stage finished publishing before raising done
+            if (upstream_done_.load(std::memory_order_acquire) && input_.empty()) {
+                break;
+            }
+            idle_polls_.add(1);
+            backoff.pause();
+        }
+    }
+
+public:
+    PipelineStage(std::string name, const StageOptions& options, input_ring& input,
+                  const std::atomic<bool>& upstream_done, F fn)
+        : PipelineStageBase(std::move(name), options),
+          input_(input),
+          upstream_done_(upstream_done),
+          fn_(std::move(fn)) {
+        if constexpr (!std::is_void_v<Out>) {
+            output_ = std::make_unique<output_ring>();
+        }
+    }
+
+    /// Ring this stage writes to (not meaningful for a sink)
+    [[nodiscard]] output_ring& output() noexcept {
+        return *output_;
+    }
+
+    void run(PipelineControl& control) override {
+        if constexpr (std::is_void_v<Out>) {
+            run_loop(control, [this](In&& item) { std::invoke(fn_, std::move(item)); }, [] {});
+        } else {
+            WriteCombiningProducer<output_ring> producer(*output_, options_.batch);
+            run_loop(
+                control,
+                [&](In&& item) { emit(producer, std::invoke(fn_, std::move(item)), control); },
+                [&producer] { producer.flush(); });
+        }
+    }
+
+    [[nodiscard]] PipelineStageStats stats() const override {
+        return make_stats(input_);
+    }
+};
+
+/// Everything a pipeline owns; heap-allocated so builders and pipelines can move
+template <typename In, std::size_t Capacity, typename Traits>
+struct PipelineState {
+    PipelineControl control;
+    RingBuffer<In, Capacity, Traits> source;
+    std::atomic<bool> source_done{false};
+    std::vector<std::unique_ptr<PipelineStageBase>> stages;
+    std::vector<std::thread> threads;
+};
+
+} // namespace detail
+
+template <typename In, std::size_t Capacity, typename Traits>
+class Pipeline;
+
+template <typename In, typename Out, std::size_t Capacity, typename Traits>
+class PipelineBuilder;
+
+template <typename In, std::size_t Capacity = 1024, typename Traits = RingBufferTraits>
+[[nodiscard]] PipelineBuilder<In, In, Capacity, Traits> make_pipeline();
+
+/**
+ * @brief Builds a pipeline stage by stage; see make_pipeline()
+ *
+ * @tparam In Type fed into the pipeline
+ * @tparam Out Type produced by the last stage so far
+ */
+template <typename In, typename Out, std::size_t Capacity, typename Traits>
+class PipelineBuilder {
+    template <typename, typename, std::size_t, typename>
+    friend class PipelineBuilder;
+    friend PipelineBuilder<In, In, Capacity, Traits> make_pipeline<In, Capacity, Traits>();
+
+    using state_type = detail::PipelineState<In, Capacity, Traits>;
+    using tail_ring = RingBuffer<Out, Capacity, Traits>;
+
+    std::unique_ptr<state_type> state_;
+    tail_ring* tail_;                       ///< Ring the next stage reads
+    const std::atomic<bool>* tail_done_;    ///< Raised once tail_ gets no more elements
+
+    PipelineBuilder(std::unique_ptr<state_type> state, tail_ring& tail, const std::atomic<bool>& tail_done) noexcept
+        : state_(std::move(state)), tail_(&tail), tail_done_(&tail_done) {}
+
+    template <typename Result, typename F>
+    [[nodiscard]] auto& add_stage(std::string name, F&& fn, StageOptions options) {
+        if (options.batch == 0) {
+            throw std::invalid_argument("Pipeline stage batch must be at least 1");
+        }
+        options.batch = std::min(options.batch, tail_ring::capacity());
+        using stage_type = detail::PipelineStage<Out, Result, std::decay_t<F>, Capacity, Traits>;
+        auto stage = std::make_unique<stage_type>(std::move(name), options, *tail_, *tail_done_,
+                                                  std::forward<F>(fn));
+        auto& added = *stage;
+        state_->stages.push_back(std::move(stage));
+        return added;
+    }
+
+public:
+    /**
+     * @brief Append a stage transforming each element with fn
+     *
+     * @param name Name reported in stats()
+     * @param fn Callable taking Out&& and returning the next stage's input
+     * @param options Pinning and batching for the stage
+     * @return The builder, now producing fn's result type
+     *
+     * @throws std::invalid_argument if options.batch is zero
+     */
+    template <typename F>
+    [[nodiscard]] auto stage(std::string name, F&& fn, const StageOptions& options = {}) && {
+        using Result = std::decay_t<std::invoke_result_t<std::decay_t<F>&, Out&&>>;
+        static_assert(!std::is_void_v<Result>, "Use sink() for a stage that returns nothing");
+        auto& added = add_stage<Result>(std::move(name), std::forward<F>(fn), options);
+        return PipelineBuilder<In, Result, Capacity, Traits>(std::move(state_), added.output(), added.done);
+    }
+
+    /**
+     * @brief Append the final stage, which consumes each element with fn
+     *
+     * @return The pipeline, not yet started
+     *
+     * @throws std::invalid_argument if options.batch is zero
+     */
+    template <typename F>
+    [[nodiscard]] Pipeline<In, Capacity, Traits> sink(std::string name, F&& fn, const StageOptions& options = {}) && {
+        static_assert(std::is_invocable_v<std::decay_t<F>&, Out&&>, "Sink must accept the last stage's output");
+        (void)add_stage<void>(std::move(name), std::forward<F>(fn), options);
+        return Pipeline<In, Capacity, Traits>(std::move(state_));
+    }
+};
+
+/**
+ * @brief A linear chain of stages, each on its own thread
+ *
+ * Consecutive stages are linked by RingBuffer<T, Capacity, Traits> rings
+ * whose element types follow the stages' signatures. Each stage pops through
+ * a LazyConsumer and pushes through a WriteCombiningProducer, so indices are
+ * published once per StageOptions::batch elements, and flushed whenever a
+ * stage runs out of input. A full ring stalls the stage feeding it, so a slow
+ * stage backs the whole pipeline up to push() rather than growing a queue.
+ *
+ * One thread feeds the pipeline through try_push() or push(). drain() lets
+ * the stages finish everything already pushed; cancel() stops them at once
+ * and discards what is still in flight. A stage that throws cancels the
+ * pipeline, and drain() rethrows its exception.
+ *
+ * @tparam In Type fed into the pipeline
+ * @tparam Capacity Slots per ring (must be a power of 2)
+ * @tparam Traits Compile-time tuning options for every ring
+ */
+template <typename In, std::size_t Capacity, typename Traits>
+class Pipeline {
+    template <typename, typename, std::size_t, typename>
+    friend class PipelineBuilder;
+
+    using state_type = detail::PipelineState<In, Capacity, Traits>;
+
+    std::unique_ptr<state_type> state_;
+
+    explicit Pipeline(std::unique_ptr<state_type> state) noexcept : state_(std::move(state)) {}
+
+    void join_all() noexcept {
+        for (auto& thread : state_->threads) {
+            thread.join();
+        }
+        state_->threads.clear();
+    }
+
+public:
+    Pipeline(Pipeline&&) noexcept = default;
+    Pipeline& operator=(Pipeline&&) = delete;
+
+    /// Drains the pipeline if it is still running, discarding any stage failure
+    ~Pipeline() {
+        if (state_ && !state_->threads.empty()) {
+            state_->source_done.store(true, std::memory_order_release);
+            join_all();
+        }
+    }
+
+    /**
+     * @brief Start one thread per stage, pinned as requested
+     *
+     * @throws std::invalid_argument or std::system_error if a thread cannot
+     *         be pinned; no stage is left running
+     */
+    void start() {
+        auto& state = *state_;
+        if (!state.threads.empty()) {
+            throw std::logic_error("Pipeline already started");
+        }
+        try {
+            for (std::size_t i = 0; i < state.stages.size(); ++i) {
+                auto* stage = state.stages[i].get();
+                state.threads.emplace_back([stage, &control = state.control] {
+                    try {
+                        stage->run(control);
+                    } catch (...) {
+                        control.fail(std::current_exception());
+                    }
+                    stage->done.store(true, std::memory_order_release);
+                });
+                if (stage->options().cpu != -1) {
+                    detail::pin_thread(state.threads.back(), stage->options().cpu);
+                }
+            }
+        } catch (...) {
+            cancel();
+            throw;
+        }
+    }
+
+    /**
+     * @brief Attempt to feed an element to the first stage
+     *
+     * @return true if the element was added, false if the first ring is full
+     *
+     * @note Only one thread may feed the pipeline
+     */
+    [[nodiscard]] bool try_push(const In& item) noexcept(std::is_nothrow_copy_constructible_v<In>) {
+        return state_->source.try_push(item);
+    }
+
+    /// Move version of try_push()
+    [[nodiscard]] bool try_push(In&& item) noexcept(std::is_nothrow_move_constructible_v<In>) {
+        return state_->source.try_push(std::move(item));
+    }
+
+    /**
+     * @brief Feed an element, waiting while the first ring is full
+     *
+     * @return true once the element is added, false if the pipeline was
+     *         cancelled (or a stage failed) first
+     *
+     * @note Only one thread may feed the pipeline
+     */
+    [[nodiscard]] bool push(In item) {
+        detail::StageBackoff backoff;
+        while (!state_->source.try_push(std::move(item))) {
+            if (state_->control.is_cancelled()) {
+                return false;
+            }
+            backoff.pause();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Let the stages finish every element pushed so far, then stop them
+     *
+     * Call from the feeding thread, after its last push.
+     *
+     * @throws The first exception thrown by a stage, if any
+     */
+    void drain() {
+        state_->source_done.store(true, std::memory_order_release);
+        join_all();
+        if (state_->control.error) {
+            std::rethrow_exception(state_->control.error);
+        }
+    }
+
+    /// Stop every stage as soon as possible, discarding elements in flight
+    void cancel() noexcept {
+        state_->control.cancelled.store(true, std::memory_order_relaxed);
+        join_all();
+    }
+
+    /**
+     * @brief Per-stage counters, in pipeline order
+     *
+     * @note May be called from any thread while the pipeline runs
+     */
+    [[nodiscard]] std::vector<PipelineStageStats> stats() const {
+        std::vector<PipelineStageStats> result;
+        result.reserve(state_->stages.size());
+        for (const auto& stage : state_->stages) {
+            result.push_back(stage->stats());
+        }
+        return result;
+    }
+
+    /// Number of stages, including the sink
+    [[nodiscard]] std::size_t stage_count() const noexcept {
+        return state_->stages.size();
+    }
+};
+
+/**
+ * @brief Start building a pipeline fed with In
+ *
+ * @tparam In Type fed into the pipeline
+ * @tparam Capacity Slots per ring (must be a power of 2)
+ * @tparam Traits Compile-time tuning options for every ring
+ *
+ * Example usage:
+ * @code
+ * lockfree::StageOptions on_cpu[3];
+ * on_cpu[0].cpu = 2;
+ * on_cpu[1].cpu = 3;
+ * on_cpu[2].cpu = 4;
+ *
+ * auto pipeline = lockfree::make_pipeline<RawPacket>()
+ *     .stage("decode", [](RawPacket p) { return decode(p); }, on_cpu[0])
+ *     .stage("normalize", [](Message m) { return normalize(std::move(m)); }, on_cpu[1])
+ *     .sink("publish", [&](Message m) { bus.publish(m); }, on_cpu[2]);
+ * pipeline.start();
+ *
+ * while (auto packet = socket.receive()) {
+ *     (void)pipeline.push(*packet);
+ * }
+ * pipeline.drain();
+ * @endcode
+ */
+template <typename In, std::size_t Capacity, typename Traits>
+PipelineBuilder<In, In, Capacity, Traits> make_pipeline() {
+    auto state = std::make_unique<detail::PipelineState<In, Capacity, Traits>>();
+    auto& source = state->source;
+    auto& source_done = state->source_done;
+    return PipelineBuilder<In, In, Capacity, Traits>(std::move(state), source, source_done);
+}
+
+} // namespace lockfree
@@ -28,101 +28,495 @@
 
 #pragma once
 
-#include <array>
+#include "ring_stats.hpp"
+#include "slot_layout.hpp"
+#include "wait_policy.hpp"
+
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <optional>
 #include <type_traits>
 
+#if __has_include(<version>)
+#include <version>
+#endif
+#if defined(__cpp_lib_span)
+#include <span>
+#endif
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
 namespace lockfree {
 
 /**
- * @brief Lock-free single-producer single-consumer ring buffer
- *
- * A high-performance circular queue optimized for scenarios where exactly one thread
- * produces data and exactly one thread consumes data. Provides wait-free operations
- * with zero memory allocation after construction.
- *
- * Key features:
- * - Lock-free and wait-free operations
- * - Cache-optimized with 64-byte alignment
- * - Zero memory allocation after construction
- * - Type-safe with move semantics support
- * - Capacity must be a power of 2 for optimal performance
- * - Actual storage capacity is Capacity-1 items
- *
- * @tparam T The type of elements stored in the ring buffer
- * @tparam Capacity The maximum number of elements (must be power of 2)
+ * @brief Compile-time tuning options for RingBuffer
  *
- * @note This implementation keeps one slot empty to distinguish between
- *       empty and full states, so effective capacity is Capacity-1.
+ * Derive from this struct and shadow individual members to change one option
+ * while keeping the defaults for the rest:
+ * @code
+ * struct UncachedTraits : lockfree::RingBufferTraits {
+ *     static constexpr bool kCacheIndices = false;
+ * };
  *
- * @warning This class is NOT thread-safe for multiple producers or consumers.
- *          Use appropriate synchronization or consider MPSC variants for such cases.
+ * lockfree::RingBuffer<int, 1024, UncachedTraits> buffer;
+ * @endcode
+ */
+struct RingBufferTraits {
+    /**
+     * When true, the producer keeps a private copy of the consumer index (and
+     * vice versa) and only reloads the shared atomic once the copy says the
+     * buffer is full (or empty). This keeps the opposite side's cache line
+     * out of the hot path while the buffer is neither full nor empty.
+     */
+    static constexpr bool kCacheIndices = true;
+
+    /**
+     * When true, head and tail are free-running counters that are only
+     * masked when indexing into the storage. All Capacity slots are then
+     * usable and size() is an exact subtraction. When false, indices are
+     * wrapped on every update and one slot is kept empty to tell a full
+     * buffer from an empty one, so only Capacity - 1 slots are usable.
+     *
+     * Counters are std::size_t; unsigned wrap-around keeps the arithmetic
+     * exact because Capacity is a power of 2.
+     */
+    static constexpr bool kFreeRunningIndices = false;
+
+    /**
+     * How the blocking operations (push, pop, try_push_for, ...) wait for
+     * the other side; see wait_policy.hpp. The choice only affects the
+     * blocking calls, except that SpinSleepWait and EventFdWait add a fence
+     * to every publish so sleeping waiters can be woken. EventFdWait also
+     * lets the consumer wait in its own epoll loop (notification_fd()).
+     */
+    using WaitPolicy = SpinYieldWait;
+
+    /**
+     * What the hot paths record; see ring_stats.hpp. NoStats compiles to
+     * nothing. CountingStats counts pushes, pops, full/empty failures, peak
+     * occupancy and batch sizes, readable from any thread through stats().
+     */
+    using Stats = NoStats;
+
+    /**
+     * How many slots ahead of the element being accessed to prefetch. The
+     * consumer prefetches slot head + k for reading and the producer slot
+     * tail + k for writing (prefetchw where the target supports it); batch
+     * operations prefetch the cache lines that move into that window. This
+     * helps large rings of big elements whose slots are cold by the time
+     * they are reached. 0 (the default) emits no prefetches.
+     */
+    static constexpr std::size_t kPrefetchDistance = 0;
+
+    /**
+     * Cache line size the indices are aligned to and that PaddedLayout and
+     * ScrambledLayout work with. Defaults to LOCKFREE_CACHE_LINE_SIZE (64);
+     * 128 suits Apple M-series and Intel parts with adjacent-line prefetch.
+     */
+    static constexpr std::size_t kCacheLineSize = detail::kCacheLineSize;
+
+    /**
+     * Where each position's slot lives; see slot_layout.hpp. PaddedLayout
+     * and ScrambledLayout keep the producer and consumer off each other's
+     * slot lines when the ring is nearly empty, but rule out the span APIs
+     * (read_span(), try_reserve_n()) for elements smaller than a line.
+     */
+    using Layout = ContiguousLayout;
+};
+
+/**
+ * @brief A contiguous run of slots inside a ring buffer
  *
- * Example usage:
- * @code
- * #include <lockfree/ring_buffer.hpp>
+ * Returned (as part of a Region) by the zero-copy APIs. The pointed-to slots
+ * belong to the buffer and are only valid until the matching commit() or
+ * release() call.
+ */
+template <typename T>
+struct Segment {
+    T* data = nullptr;      ///< First slot of the run
+    std::size_t size = 0;   ///< Number of slots in the run
+
+    [[nodiscard]] T* begin() const noexcept { return data; }
+    [[nodiscard]] T* end() const noexcept { return data + size; }
+    [[nodiscard]] bool empty() const noexcept { return size == 0; }
+    [[nodiscard]] T& operator[](std::size_t index) const noexcept { return data[index]; }
+};
+
+/**
+ * @brief A possibly wrapping region of a ring buffer as up to two segments
  *
- * lockfree::RingBuffer<int, 1024> buffer;
+ * The first segment runs up to the end of the storage; the second one, if
+ * non-empty, continues from the start of the storage.
+ */
+template <typename T>
+struct Region {
+    Segment<T> first;   ///< Slots before the wrap point
+    Segment<T> second;  ///< Slots after the wrap point
+
+    [[nodiscard]] std::size_t size() const noexcept { return first.size + second.size; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+};
+
+namespace detail {
+
+/// Hint that the cache line at address will be read soon
+inline void prefetch_for_read(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+/// Hint that the cache line at address will be written soon
+inline void prefetch_for_write(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 1, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+#if defined(__AVX512F__)
+/// Bytes per non-temporal store; 0 where stream_copy() falls back to memcpy
+inline constexpr std::size_t kStreamWidth = 64;
+
+inline void stream_vector(void* dst, const void* src) noexcept {
+    _mm512_stream_si512(static_cast<__m512i*>(dst), _mm512_loadu_si512(src));
+}
+#elif defined(__AVX__)
+inline constexpr std::size_t kStreamWidth = 32;
+
+inline void stream_vector(void* dst, const void* src) noexcept {
+    _mm256_stream_si256(static_cast<__m256i*>(dst), _mm256_loadu_si256(static_cast<const __m256i*>(src)));
+}
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+inline constexpr std::size_t kStreamWidth = 16;
+
+inline void stream_vector(void* dst, const void* src) noexcept {
+    _mm_stream_si128(static_cast<__m128i*>(dst), _mm_loadu_si128(static_cast<const __m128i*>(src)));
+}
+#else
+inline constexpr std::size_t kStreamWidth = 0;
+#endif
+
+/**
+ * Copy bytes from src to dst, writing dst with non-temporal stores where the
+ * target has them (SSE2, AVX or AVX-512 on x86) so the copy does not evict
+ * the consumer's working set. Small copies and other targets use memcpy.
+ * Ends with a store fence, so dst can be handed to another thread as usual.
+ */
+inline void stream_copy(void* dst, const void* src, std::size_t bytes) noexcept {
+#if !defined(__AVX512F__) && !defined(__AVX__) && !defined(__SSE2__) && !defined(_M_X64) && \
+    !(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    std::memcpy(dst, src, bytes);
+#else
+    auto* out = static_cast<unsigned char*>(dst);
+    const auto* in = static_cast<const unsigned char*>(src);
+    if (bytes >= 4 * kStreamWidth) {
+        // Streaming stores need an aligned destination
+        const auto misalignment = reinterpret_cast<std::uintptr_t>(out) & (kStreamWidth - 1);
+        if (misalignment != 0) {
+            const auto lead = kStreamWidth - misalignment;
+            std::memcpy(out, in, lead);
+            out += lead;
+            in += lead;
+            bytes -= lead;
+        }
+        for (; bytes >= kStreamWidth; bytes -= kStreamWidth, out += kStreamWidth, in += kStreamWidth) {
+            stream_vector(out, in);
+        }
+        _mm_sfence();
+    }
+    std::memcpy(out, in, bytes);
+#endif
+}
+
+/**
+ * @brief Shared SPSC protocol behind RingBuffer and its variants
  *
- * // Producer thread
- * if (buffer.try_push(42)) {
- *     // Success
- * }
+ * Holds the head/tail indices and implements every producer and consumer
+ * operation. The storage lives in the derived class, which must provide:
+ * - index_mask(): the number of slots minus one (static constexpr for
+ *   fixed-capacity buffers so the mask folds into the instructions)
+ * - slot_data(): pointer to the first of index_mask() + 1 slot_type objects
  *
- * // Consumer thread
- * if (auto item = buffer.try_pop()) {
- *     // Process *item
- * }
- * @endcode
+ * Derived classes must call destroy_all() from their destructor while the
+ * storage is still alive.
  */
-template <typename T, std::size_t Capacity>
-class RingBuffer {
+template <typename Derived, typename T, typename Traits>
+class RingBufferCore {
     static_assert(std::is_move_constructible_v<T>,
                   "T must be move constructible");
-    static_assert(std::is_move_assignable_v<T>,
-                  "T must be move assignable");
-    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 1,
-                  "Capacity must be a power of 2 and greater than 1");
+    static_assert((Traits::kCacheLineSize & (Traits::kCacheLineSize - 1)) == 0 &&
+                      Traits::kCacheLineSize >= alignof(std::max_align_t),
+                  "kCacheLineSize must be a power of 2 no smaller than alignof(std::max_align_t)");
 
-private:
-    static constexpr std::size_t kIndexMask = Capacity - 1;
+    using SlotLayout = typename Traits::Layout::template Slots<T, Traits::kCacheLineSize>;
+    static_assert(!SlotLayout::kContiguous || sizeof(typename SlotLayout::slot_type) == sizeof(T),
+                  "Contiguous slots must be adjacent so runs of slots can be used as T arrays");
 
-    // Separate cache lines to prevent false sharing between producer and consumer
-    alignas(64) std::atomic<std::size_t> head_{0};  ///< Consumer index
-    alignas(64) std::atomic<std::size_t> tail_{0};  ///< Producer index
+    static constexpr std::size_t kLineSize = Traits::kCacheLineSize;
 
-    // Data storage aligned to cache line boundary
-    alignas(64) std::array<T, Capacity> buffer_;
+    // Separate cache lines to prevent false sharing between producer and consumer.
+    // Each side's private copy of the opposite index shares the line of the
+    // index that side writes, so it never causes extra coherence traffic.
+    // Each side's stats counters follow its index, on lines only that side
+    // writes; the next alignas member starts a new line however many they span.
+    alignas(kLineSize) std::atomic<std::size_t> head_{0};  ///< Consumer index
+    std::size_t tail_cache_{0};                            ///< Consumer's copy of tail_
+    typename Traits::Stats::Consumer consumer_stats_;      ///< Consumer-side counters
+    alignas(kLineSize) std::atomic<std::size_t> tail_{0};  ///< Producer index
+    std::size_t head_cache_{0};                            ///< Producer's copy of head_
+    typename Traits::Stats::Producer producer_stats_;      ///< Producer-side counters
 
-public:
-    /// The type of elements stored in the buffer
-    using value_type = T;
-    /// The size type used for indices and sizes
-    using size_type = std::size_t;
+    using WaitPolicy = typename Traits::WaitPolicy;
+    using WaitState = typename WaitPolicy::State;
+
+    // Waiter state is read on every publish but only written by a waiter, so
+    // it gets its own line unless the policy is stateless.
+    static constexpr std::size_t kWaitStateAlignment =
+        std::is_empty_v<WaitState> ? alignof(WaitState) : kLineSize;
+    static constexpr bool kPollableWait = detail::is_pollable_wait<WaitPolicy>::value;
+    alignas(kWaitStateAlignment) WaitState not_empty_;  ///< Consumer waits for data here
+    WaitState not_full_;                                ///< Producer waits for space here
+
+    [[nodiscard]] Derived& derived() noexcept {
+        return static_cast<Derived&>(*this);
+    }
+
+    [[nodiscard]] std::size_t index_mask() const noexcept {
+        return static_cast<const Derived&>(*this).index_mask();
+    }
+
+    /// Total number of slots in the storage
+    [[nodiscard]] std::size_t slot_count() const noexcept {
+        return index_mask() + 1;
+    }
+
+    /// Number of slots that can hold elements at the same time
+    [[nodiscard]] std::size_t usable_slots() const noexcept {
+        return Traits::kFreeRunningIndices ? slot_count() : slot_count() - 1;
+    }
+
+    /// Uninitialized storage of a slot, for constructing a new element
+    [[nodiscard]] void* slot_storage(std::size_t slot) noexcept {
+        return derived().slot_data()[slot].bytes;
+    }
+
+    /// Live element in a slot (only valid between head_ and tail_)
+    [[nodiscard]] T* slot_ptr(std::size_t slot) noexcept {
+        return std::launder(reinterpret_cast<T*>(derived().slot_data()[slot].bytes));
+    }
+
+    /// Destroy count live elements starting at index
+    void destroy_range(std::size_t index, std::size_t count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i = 0; i < count; ++i) {
+                std::destroy_at(slot_ptr(slot_of(index + i)));
+            }
+        }
+    }
 
     /**
-     * @brief Default constructor
-     *
-     * Constructs an empty ring buffer. All elements in the internal storage
-     * are default-constructed.
+     * Construct count elements from src into the slots starting at index.
+     * If a constructor throws, the elements built so far are destroyed and
+     * the exception is rethrown, leaving the slots unpublished.
      */
-    RingBuffer() = default;
+    template <typename InputIt>
+    void construct_range(std::size_t index, std::size_t count, InputIt src) {
+        std::size_t built = 0;
+        try {
+            for (; built < count; ++built, ++src) {
+                ::new (slot_storage(slot_of(index + built))) T(*src);
+            }
+        } catch (...) {
+            destroy_range(index, built);
+            throw;
+        }
+    }
+
+    /// Index n positions after index (wrapped unless indices are free-running)
+    [[nodiscard]] std::size_t advance(std::size_t index, std::size_t n) const noexcept {
+        if constexpr (Traits::kFreeRunningIndices) {
+            return index + n;
+        } else {
+            return (index + n) & index_mask();
+        }
+    }
+
+    /// Number of occupied slots between head and tail
+    [[nodiscard]] std::size_t distance(std::size_t head, std::size_t tail) const noexcept {
+        if constexpr (Traits::kFreeRunningIndices) {
+            return tail - head;
+        } else {
+            return (tail - head) & index_mask();
+        }
+    }
+
+    /// Storage slot for an index
+    [[nodiscard]] std::size_t slot_of(std::size_t index) const noexcept {
+        return SlotLayout::slot_of(index, index_mask());
+    }
+
+    /// Make everything before new_tail visible to the consumer
+    void publish_tail(std::size_t new_tail) noexcept {
+        tail_.store(new_tail, std::memory_order_release);
+        WaitPolicy::notify(not_empty_);
+    }
+
+    /// Hand everything before new_head back to the producer
+    void publish_head(std::size_t new_head) noexcept {
+        head_.store(new_head, std::memory_order_release);
+        WaitPolicy::notify(not_full_);
+    }
 
     /**
-     * @brief Destructor
-     *
-     * Destroys the ring buffer. Note that this does not call destructors
-     * on remaining elements in the buffer. Users should drain the buffer
-     * before destruction if needed.
+     * Prefetch ahead of an operation on the count slots starting at index:
+     * the slots from index + kPrefetchDistance up to index + count +
+     * kPrefetchDistance, skipping any the operation itself touches. Earlier
+     * operations already covered everything before that window.
      */
-    ~RingBuffer() = default;
+    template <bool ForWrite>
+    void prefetch_ahead(std::size_t index, std::size_t count) noexcept {
+        if constexpr (Traits::kPrefetchDistance != 0) {
+            // Consecutive positions only share lines when the layout keeps them adjacent
+            constexpr std::size_t kSlotsPerLine =
+                SlotLayout::kContiguous ? std::max<std::size_t>(1, kLineSize / sizeof(T)) : 1;
+            const auto last = index + count + Traits::kPrefetchDistance - 1;
+            auto position = index + std::max(count, Traits::kPrefetchDistance);
+            for (; position < last; position += kSlotsPerLine) {
+                prefetch_slot<ForWrite>(position);
+            }
+            prefetch_slot<ForWrite>(last);
+        }
+    }
 
-    // Non-copyable and non-movable for safety
-    RingBuffer(const RingBuffer&) = delete;
-    RingBuffer& operator=(const RingBuffer&) = delete;
-    RingBuffer(RingBuffer&&) = delete;
-    RingBuffer& operator=(RingBuffer&&) = delete;
+    template <bool ForWrite>
+    void prefetch_slot(std::size_t index) noexcept {
+        if constexpr (ForWrite) {
+            prefetch_for_write(slot_storage(slot_of(index)));
+        } else {
+            prefetch_for_read(slot_storage(slot_of(index)));
+        }
+    }
+
+    /// Write fn(std::move(run[i])) to out for the n elements of run
+    template <typename OutputIt, typename F>
+    static OutputIt transform_run(T* run, std::size_t n, OutputIt out, F& fn) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            *out++ = std::invoke(fn, std::move(run[i]));
+        }
+        return out;
+    }
+
+    /// Record count elements published up to new_tail
+    void record_push(std::size_t new_tail, std::size_t count) noexcept {
+        if constexpr (Traits::Stats::kEnabled) {
+            // The cached head is at most one refresh stale, so this is an upper bound
+            const auto head = Traits::kCacheIndices ? head_cache_ : head_.load(std::memory_order_relaxed);
+            producer_stats_.pushed(count, distance(head, new_tail));
+        }
+    }
+
+    /// Producer side: wait until at least one slot is free
+    template <typename Deadline>
+    [[nodiscard]] bool wait_for_space(const Deadline& deadline) {
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        return WaitPolicy::wait(not_full_, [&] { return !would_overrun(current_tail); }, deadline);
+    }
+
+    /// Consumer side: wait until at least one element is readable
+    template <typename Deadline>
+    [[nodiscard]] bool wait_for_data(const Deadline& deadline) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        return WaitPolicy::wait(not_empty_, [&] { return !is_drained(current_head); }, deadline);
+    }
+
+    /**
+     * Producer-side full check: true if there is no free slot at tail.
+     * Only touches head_ when the cached copy says the buffer is full.
+     */
+    [[nodiscard]] bool would_overrun(std::size_t tail) noexcept {
+        if constexpr (Traits::kCacheIndices) {
+            if (distance(head_cache_, tail) != usable_slots()) {
+                return false;
+            }
+            head_cache_ = head_.load(std::memory_order_acquire);
+            return distance(head_cache_, tail) == usable_slots();
+        } else {
+            return distance(head_.load(std::memory_order_acquire), tail) == usable_slots();
+        }
+    }
+
+    /**
+     * Consumer-side empty check: true if there is nothing to read at
+     * current_head. Only touches tail_ when the cached copy says the buffer
+     * is empty.
+     */
+    [[nodiscard]] bool is_drained(std::size_t current_head) noexcept {
+        if constexpr (Traits::kCacheIndices) {
+            if (current_head != tail_cache_) {
+                return false;
+            }
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            return current_head == tail_cache_;
+        } else {
+            return current_head == tail_.load(std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * Producer-side free space starting at tail. The cached head is only
+     * refreshed when it cannot satisfy the requested count.
+     */
+    [[nodiscard]] std::size_t writable(std::size_t tail, std::size_t wanted) noexcept {
+        if constexpr (Traits::kCacheIndices) {
+            const auto cached = usable_slots() - distance(head_cache_, tail);
+            if (cached >= wanted) {
+                return cached;
+            }
+            head_cache_ = head_.load(std::memory_order_acquire);
+            return usable_slots() - distance(head_cache_, tail);
+        } else {
+            return usable_slots() - distance(head_.load(std::memory_order_acquire), tail);
+        }
+    }
+
+    /**
+     * Consumer-side readable count starting at head. The cached tail is only
+     * refreshed when it cannot satisfy the requested count.
+     */
+    [[nodiscard]] std::size_t readable(std::size_t head, std::size_t wanted) noexcept {
+        if constexpr (Traits::kCacheIndices) {
+            const auto cached = distance(head, tail_cache_);
+            if (cached >= wanted) {
+                return cached;
+            }
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            return distance(head, tail_cache_);
+        } else {
+            return distance(head, tail_.load(std::memory_order_acquire));
+        }
+    }
+
+public:
+    /// The type of elements stored in the buffer
+    using value_type = T;
+    /// The size type used for indices and sizes
+    using size_type = std::size_t;
 
     /**
      * @brief Attempt to push an element (copy version)
@@ -135,21 +529,8 @@ public:
      *
      * @note This function should only be called from the producer thread
      */
-    [[nodiscard]] bool try_push(const T& item) noexcept(std::is_nothrow_copy_assignable_v<T>) {
-        const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto next_tail = (current_tail + 1) & kIndexMask;
-
-        // Check if buffer is full
-        if (next_tail == head_.load(std::memory_order_acquire)) {
-            return false;
-        }
-
-        // Store the item
-        buffer_[current_tail] = item;
-
-        // Publish the new tail position
-        tail_.store(next_tail, std::memory_order_release);
-        return true;
+    [[nodiscard]] bool try_push(const T& item) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return try_emplace(item);
     }
 
     /**
@@ -163,20 +544,40 @@ public:
      *
      * @note This function should only be called from the producer thread
      */
-    [[nodiscard]] bool try_push(T&& item) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    [[nodiscard]] bool try_push(T&& item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return try_emplace(std::move(item));
+    }
+
+    /**
+     * @brief Attempt to construct an element in place
+     *
+     * Constructs the element directly in its slot from the given arguments.
+     * This operation is wait-free for the producer thread.
+     *
+     * @param args Arguments forwarded to the constructor of T
+     * @return true if the element was successfully added, false if buffer is full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args)
+        noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
         const auto current_tail = tail_.load(std::memory_order_relaxed);
-        const auto next_tail = (current_tail + 1) & kIndexMask;
 
         // Check if buffer is full
-        if (next_tail == head_.load(std::memory_order_acquire)) {
+        if (would_overrun(current_tail)) {
+            producer_stats_.full();
             return false;
         }
+        prefetch_ahead<true>(current_tail, 1);
 
-        // Move the item
-        buffer_[current_tail] = std::move(item);
+        // Construct the item in its slot
+        ::new (slot_storage(slot_of(current_tail))) T(std::forward<Args>(args)...);
 
         // Publish the new tail position
-        tail_.store(next_tail, std::memory_order_release);
+        const auto new_tail = advance(current_tail, 1);
+        publish_tail(new_tail);
+        record_push(new_tail, 1);
         return true;
     }
 
@@ -195,56 +596,863 @@ public:
         const auto current_head = head_.load(std::memory_order_relaxed);
 
         // Check if buffer is empty
-        if (current_head == tail_.load(std::memory_order_acquire)) {
+        if (is_drained(current_head)) {
+            consumer_stats_.empty();
             return std::nullopt;
         }
+        prefetch_ahead<false>(current_head, 1);
 
-        // Move the item out of the buffer
-        T item = std::move(buffer_[current_head]);
+        // Move the item out of the buffer and end the slot's lifetime
+        T* slot = slot_ptr(slot_of(current_head));
+        std::optional<T> item(std::move(*slot));
+        std::destroy_at(slot);
 
         // Publish the new head position
-        head_.store((current_head + 1) & kIndexMask, std::memory_order_release);
+        publish_head(advance(current_head, 1));
+        consumer_stats_.popped(1);
         return item;
     }
 
     /**
-     * @brief Check if the buffer appears empty
+     * @brief Attempt to pop an element into out
      *
-     * @return true if the buffer appears empty at the time of the call
+     * Same as try_pop(), but move-assigns the element to out instead of
+     * returning a std::optional. For small trivially copyable T this keeps
+     * the element in a register: returning std::optional<std::uint64_t>
+     * goes through the stack on the common x86-64 ABIs, this does not.
      *
-     * @note This is an approximate check. The state may change immediately
-     *       after this function returns due to concurrent operations.
+     * @param out Receives the popped element; unchanged if the buffer is empty
+     * @return true if an element was popped, false if the buffer is empty
+     *
+     * @note This function should only be called from the consumer thread
      */
-    [[nodiscard]] bool empty() const noexcept {
-        return head_.load(std::memory_order_relaxed) ==
-               tail_.load(std::memory_order_relaxed);
+    [[nodiscard]] bool try_pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+
+        if (is_drained(current_head)) {
+            consumer_stats_.empty();
+            return false;
+        }
+        prefetch_ahead<false>(current_head, 1);
+
+        T* slot = slot_ptr(slot_of(current_head));
+        out = std::move(*slot);
+        std::destroy_at(slot);
+
+        publish_head(advance(current_head, 1));
+        consumer_stats_.popped(1);
+        return true;
     }
 
     /**
-     * @brief Check if the buffer appears full
+     * @brief Push an element, waiting for space if the buffer is full
      *
-     * @return true if the buffer appears full at the time of the call
+     * Waits according to Traits::WaitPolicy.
      *
-     * @note This is an approximate check. The state may change immediately
-     *       after this function returns due to concurrent operations.
+     * @param item The element to add to the buffer
+     *
+     * @note This function should only be called from the producer thread
      */
-    [[nodiscard]] bool full() const noexcept {
-        const auto next_tail = (tail_.load(std::memory_order_relaxed) + 1) & kIndexMask;
-        return next_tail == head_.load(std::memory_order_relaxed);
+    void push(const T& item) {
+        emplace(item);
     }
 
     /**
-     * @brief Get the approximate current size
+     * @brief Push an element (move version), waiting for space if the buffer is full
      *
-     * @return The approximate number of elements currently in the buffer
+     * @param item The element to move into the buffer
      *
-     * @note This is an approximate value. The actual size may change
-     *       immediately after this function returns due to concurrent operations.
+     * @note This function should only be called from the producer thread
      */
-    [[nodiscard]] size_type size() const noexcept {
-        const auto head = head_.load(std::memory_order_relaxed);
-        const auto tail = tail_.load(std::memory_order_relaxed);
-        return (tail - head) & kIndexMask;
+    void push(T&& item) {
+        emplace(std::move(item));
+    }
+
+    /**
+     * @brief Construct an element in place, waiting for space if the buffer is full
+     *
+     * @param args Arguments forwarded to the constructor of T
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        (void)wait_for_space(detail::NoDeadline{});
+        (void)try_emplace(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Pop an element, waiting for one if the buffer is empty
+     *
+     * Waits according to Traits::WaitPolicy.
+     *
+     * @return The oldest element in the buffer
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] T pop() {
+        (void)wait_for_data(detail::NoDeadline{});
+        return std::move(*try_pop());
+    }
+
+    /**
+     * @brief Push an element, waiting at most timeout for space
+     *
+     * @return true if the element was added, false if the buffer stayed full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename Rep, typename Period>
+    [[nodiscard]] bool try_push_for(const T& item, const std::chrono::duration<Rep, Period>& timeout) {
+        return try_push_until(item, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /// Move version of try_push_for()
+    template <typename Rep, typename Period>
+    [[nodiscard]] bool try_push_for(T&& item, const std::chrono::duration<Rep, Period>& timeout) {
+        return try_push_until(std::move(item), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Push an element, waiting until deadline for space
+     *
+     * @return true if the element was added, false if the buffer stayed full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename Clock, typename Duration>
+    [[nodiscard]] bool try_push_until(const T& item,
+                                      const std::chrono::time_point<Clock, Duration>& deadline) {
+        return wait_for_space(detail::Deadline<Clock, Duration>{deadline}) && try_emplace(item);
+    }
+
+    /// Move version of try_push_until()
+    template <typename Clock, typename Duration>
+    [[nodiscard]] bool try_push_until(T&& item,
+                                      const std::chrono::time_point<Clock, Duration>& deadline) {
+        return wait_for_space(detail::Deadline<Clock, Duration>{deadline}) &&
+               try_emplace(std::move(item));
+    }
+
+    /**
+     * @brief Pop an element, waiting at most timeout for one
+     *
+     * @return The oldest element, or std::nullopt if the buffer stayed empty
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    template <typename Rep, typename Period>
+    [[nodiscard]] std::optional<T> try_pop_for(const std::chrono::duration<Rep, Period>& timeout) {
+        return try_pop_until(std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @brief Pop an element, waiting until deadline for one
+     *
+     * @return The oldest element, or std::nullopt if the buffer stayed empty
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    template <typename Clock, typename Duration>
+    [[nodiscard]] std::optional<T> try_pop_until(const std::chrono::time_point<Clock, Duration>& deadline) {
+        if (!wait_for_data(detail::Deadline<Clock, Duration>{deadline})) {
+            return std::nullopt;
+        }
+        return try_pop();
+    }
+
+    /**
+     * @brief Attempt to push a contiguous range of elements
+     *
+     * Copies as many of the n elements as currently fit, in at most two
+     * segments (before and after the wrap point), and publishes the new tail
+     * once for the whole batch. Trivially copyable types are copied with
+     * memcpy.
+     *
+     * @param first Pointer to the first element to copy
+     * @param n Number of elements available at first
+     * @return The number of elements pushed (0 if the buffer is full)
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] size_type try_push_n(const T* first, size_type n)
+        noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        const auto count = std::min(n, writable(current_tail, n));
+        if (count == 0) {
+            producer_stats_.full();
+            return 0;
+        }
+        prefetch_ahead<true>(current_tail, count);
+
+        if constexpr (std::is_trivially_copyable_v<T> && SlotLayout::kContiguous) {
+            // Copy up to the end of the storage, then the remainder from the start
+            const auto start = slot_of(current_tail);
+            const auto first_run = std::min(count, slot_count() - start);
+            std::memcpy(slot_storage(start), first, first_run * sizeof(T));
+            std::memcpy(slot_storage(0), first + first_run, (count - first_run) * sizeof(T));
+        } else {
+            construct_range(current_tail, count, first);
+        }
+
+        // Publish the whole batch at once
+        const auto new_tail = advance(current_tail, count);
+        publish_tail(new_tail);
+        record_push(new_tail, count);
+        return count;
+    }
+
+    /**
+     * @brief Attempt to push the elements of an iterator range
+     *
+     * Same semantics as the pointer overload: pushes as many elements of
+     * [first, last) as currently fit and publishes the tail once.
+     *
+     * @param first Iterator to the first element to copy
+     * @param last Iterator past the last element to copy
+     * @return The number of elements pushed (0 if the buffer is full)
+     *
+     * @note This function should only be called from the producer thread
+     */
+    template <typename ForwardIt>
+    [[nodiscard]] size_type try_push_n(ForwardIt first, ForwardIt last) {
+        if constexpr (std::is_same_v<ForwardIt, T*> || std::is_same_v<ForwardIt, const T*>) {
+            return try_push_n(static_cast<const T*>(first), static_cast<size_type>(last - first));
+        }
+
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        const auto wanted = static_cast<size_type>(std::distance(first, last));
+        const auto count = std::min(wanted, writable(current_tail, wanted));
+        if (count == 0) {
+            producer_stats_.full();
+            return 0;
+        }
+        prefetch_ahead<true>(current_tail, count);
+
+        construct_range(current_tail, count, first);
+
+        const auto new_tail = advance(current_tail, count);
+        publish_tail(new_tail);
+        record_push(new_tail, count);
+        return count;
+    }
+
+    /**
+     * @brief Attempt to pop up to max elements into a contiguous array
+     *
+     * Moves as many elements as are available (up to max) in at most two
+     * segments and publishes the new head once for the whole batch.
+     * Trivially copyable types are copied with memcpy.
+     *
+     * @param out Destination array with room for at least max elements
+     * @param max Maximum number of elements to pop
+     * @return The number of elements popped (0 if the buffer is empty)
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] size_type try_pop_n(T* out, size_type max)
+        noexcept(std::is_nothrow_move_assignable_v<T>) {
+        if constexpr (std::is_trivially_copyable_v<T> && SlotLayout::kContiguous) {
+            const auto current_head = head_.load(std::memory_order_relaxed);
+            const auto count = std::min(max, readable(current_head, max));
+            if (count == 0) {
+                consumer_stats_.empty();
+                return 0;
+            }
+            prefetch_ahead<false>(current_head, count);
+
+            const auto start = slot_of(current_head);
+            const auto first_run = std::min(count, slot_count() - start);
+            std::memcpy(out, slot_ptr(start), first_run * sizeof(T));
+            std::memcpy(out + first_run, slot_ptr(0), (count - first_run) * sizeof(T));
+
+            publish_head(advance(current_head, count));
+            consumer_stats_.popped(count);
+            return count;
+        } else {
+            return try_pop_n<T*>(out, max);
+        }
+    }
+
+    /**
+     * @brief Attempt to pop up to max elements, writing them with non-temporal stores
+     *
+     * Same as try_pop_n(T*, size_type), but large batches are copied to out
+     * with streaming stores that bypass the cache (on x86; elsewhere this is
+     * plain try_pop_n()). Use it when the destination will not be read again
+     * soon, e.g. batches written to a capture buffer, so the copy does not
+     * evict the consumer's working set.
+     *
+     * @param out Destination array with room for at least max elements
+     * @param max Maximum number of elements to pop
+     * @return The number of elements popped (0 if the buffer is empty)
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] size_type try_pop_n_streaming(T* out, size_type max) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "try_pop_n_streaming() needs a trivially copyable T");
+        if constexpr (SlotLayout::kContiguous && detail::kStreamWidth != 0) {
+            const auto current_head = head_.load(std::memory_order_relaxed);
+            const auto count = std::min(max, readable(current_head, max));
+            if (count == 0) {
+                consumer_stats_.empty();
+                return 0;
+            }
+            prefetch_ahead<false>(current_head, count);
+
+            const auto start = slot_of(current_head);
+            const auto first_run = std::min(count, slot_count() - start);
+            detail::stream_copy(out, slot_ptr(start), first_run * sizeof(T));
+            detail::stream_copy(out + first_run, slot_ptr(0), (count - first_run) * sizeof(T));
+
+            publish_head(advance(current_head, count));
+            consumer_stats_.popped(count);
+            return count;
+        } else {
+            return try_pop_n(out, max);
+        }
+    }
+
+    /**
+     * @brief Attempt to pop up to max elements, passing each through fn on the way out
+     *
+     * Writes fn(std::move(element)) to out for each popped element, so a
+     * batch goes from the ring to its destination in one pass instead of a
+     * copy followed by a second pass over the data. With a contiguous layout,
+     * trivially destructible T and a non-throwing fn, each run of slots is a
+     * plain loop that the compiler can vectorize for simple kernels.
+     *
+     * If fn or the assignment throws, the elements already written are
+     * removed and the rest (including the one that threw) stay in the buffer.
+     *
+     * @param out Output iterator receiving the results
+     * @param max Maximum number of elements to pop
+     * @param fn Callable taking T&& and returning a value assignable to *out
+     * @return The number of elements popped (0 if the buffer is empty)
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    template <typename OutputIt, typename F>
+    [[nodiscard]] size_type try_pop_n_transform(OutputIt out, size_type max, F&& fn) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        const auto count = std::min(max, readable(current_head, max));
+        if (count == 0) {
+            consumer_stats_.empty();
+            return 0;
+        }
+        prefetch_ahead<false>(current_head, count);
+
+        if constexpr (SlotLayout::kContiguous && std::is_trivially_destructible_v<T> &&
+                      std::is_nothrow_invocable_v<F&, T&&> &&
+                      noexcept(*out++ = std::invoke(fn, std::declval<T&&>()))) {
+            const auto start = slot_of(current_head);
+            const auto first_run = std::min(count, slot_count() - start);
+            out = transform_run(slot_ptr(start), first_run, out, fn);
+            (void)transform_run(slot_ptr(0), count - first_run, out, fn);
+        } else {
+            size_type done = 0;
+            try {
+                for (; done < count; ++done) {
+                    T* slot = slot_ptr(slot_of(current_head + done));
+                    *out++ = std::invoke(fn, std::move(*slot));
+                    std::destroy_at(slot);
+                }
+            } catch (...) {
+                publish_head(advance(current_head, done));
+                if (done != 0) {
+                    consumer_stats_.popped(done);
+                }
+                throw;
+            }
+        }
+
+        publish_head(advance(current_head, count));
+        consumer_stats_.popped(count);
+        return count;
+    }
+
+    /**
+     * @brief Attempt to pop up to max elements through an output iterator
+     *
+     * Same semantics as the pointer overload, for destinations such as
+     * std::back_inserter. If assigning to the destination throws, the
+     * elements already written are removed and the rest stay in the buffer.
+     *
+     * @param out Output iterator receiving the popped elements
+     * @param max Maximum number of elements to pop
+     * @return The number of elements popped (0 if the buffer is empty)
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    template <typename OutputIt>
+    [[nodiscard]] size_type try_pop_n(OutputIt out, size_type max) {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        const auto count = std::min(max, readable(current_head, max));
+        if (count == 0) {
+            consumer_stats_.empty();
+            return 0;
+        }
+        prefetch_ahead<false>(current_head, count);
+
+        // If a move throws, publish the elements already handed out and leave
+        // the rest (including the one that threw) in the buffer
+        size_type done = 0;
+        try {
+            for (; done < count; ++done) {
+                T* slot = slot_ptr(slot_of(current_head + done));
+                *out++ = std::move(*slot);
+                std::destroy_at(slot);
+            }
+        } catch (...) {
+            publish_head(advance(current_head, done));
+            if (done != 0) {
+                consumer_stats_.popped(done);
+            }
+            throw;
+        }
+
+        publish_head(advance(current_head, count));
+        consumer_stats_.popped(count);
+        return count;
+    }
+
+#if defined(__cpp_lib_span)
+    /**
+     * @brief Attempt to push the elements of a span
+     * @return The number of elements pushed
+     */
+    [[nodiscard]] size_type try_push_n(std::span<const T> items)
+        noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return try_push_n(items.data(), items.size());
+    }
+
+    /**
+     * @brief Attempt to pop into a span, up to its size
+     * @return The number of elements popped
+     */
+    [[nodiscard]] size_type try_pop_n(std::span<T> out)
+        noexcept(std::is_nothrow_move_assignable_v<T>) {
+        return try_pop_n(out.data(), out.size());
+    }
+#endif
+
+    /**
+     * @brief Reserve the next slot for in-place writing
+     *
+     * Returns a pointer to the slot the next push would use, so the element
+     * can be built directly in the buffer. The slot is uninitialized storage:
+     * construct the element with placement new (for implicit-lifetime types
+     * such as trivially copyable structs, writing the members is enough).
+     * The slot becomes visible to the consumer only after commit().
+     *
+     * @return Pointer to the reserved slot, or nullptr if the buffer is full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] T* try_reserve() noexcept {
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        if (would_overrun(current_tail)) {
+            producer_stats_.full();
+            return nullptr;
+        }
+        prefetch_ahead<true>(current_tail, 1);
+        return static_cast<T*>(slot_storage(slot_of(current_tail)));
+    }
+
+    /**
+     * @brief Reserve the slot after pending uncommitted reservations
+     *
+     * Lets elements be staged one at a time and published together: with
+     * pending slots already reserved (and constructed) since the last
+     * commit(), returns the next one, so commit(pending + 1) publishes them
+     * all in order. try_reserve(0) is try_reserve().
+     *
+     * @param pending Number of slots reserved since the last commit()
+     * @return Pointer to the reserved slot, or nullptr if the buffer is full
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] T* try_reserve(size_type pending) noexcept {
+        const auto position = advance(tail_.load(std::memory_order_relaxed), pending);
+        if (would_overrun(position)) {
+            producer_stats_.full();
+            return nullptr;
+        }
+        prefetch_ahead<true>(position, 1);
+        return static_cast<T*>(slot_storage(slot_of(position)));
+    }
+
+    /**
+     * @brief Reserve up to n slots for in-place writing
+     *
+     * @param n Maximum number of slots to reserve
+     * @return The reserved slots as up to two segments of uninitialized
+     *         storage (see try_reserve()); its size() may be smaller than n
+     *         (zero if the buffer is full)
+     *
+     * @note This function should only be called from the producer thread
+     */
+    [[nodiscard]] Region<T> try_reserve_n(size_type n) noexcept {
+        static_assert(SlotLayout::kContiguous,
+                      "try_reserve_n() needs a contiguous slot layout; use try_reserve() and commit()");
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        const auto count = std::min(n, writable(current_tail, n));
+        if (count == 0) {
+            producer_stats_.full();
+        } else {
+            prefetch_ahead<true>(current_tail, count);
+        }
+        const auto start = slot_of(current_tail);
+        const auto first_run = std::min(count, slot_count() - start);
+        return {{static_cast<T*>(slot_storage(start)), first_run},
+                {static_cast<T*>(slot_storage(0)), count - first_run}};
+    }
+
+    /**
+     * @brief Publish slots previously obtained from try_reserve()/try_reserve_n()
+     *
+     * @param n Number of reserved slots to publish, in order
+     *
+     * @warning n must not exceed the number of slots reserved since the last
+     *          commit, and each of those slots must hold a constructed element.
+     *
+     * @note This function should only be called from the producer thread
+     */
+    void commit(size_type n = 1) noexcept {
+        const auto current_tail = tail_.load(std::memory_order_relaxed);
+        const auto new_tail = advance(current_tail, n);
+        publish_tail(new_tail);
+        if (n != 0) {
+            record_push(new_tail, n);
+        }
+    }
+
+    /**
+     * @brief Peek at the oldest element without removing it
+     *
+     * @return Pointer to the oldest element, or nullptr if the buffer is empty.
+     *         The pointer stays valid until pop_front() or release().
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] const T* front() noexcept {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        if (is_drained(current_head)) {
+            consumer_stats_.empty();
+            return nullptr;
+        }
+        prefetch_ahead<false>(current_head, 1);
+        return slot_ptr(slot_of(current_head));
+    }
+
+    /**
+     * @brief Take the element after pending acquired but unreleased ones
+     *
+     * The consumer-side mirror of try_reserve(pending): elements can be
+     * taken one at a time and their slots handed back together. With pending
+     * elements acquired since the last release(), returns the next one, so
+     * release(pending + 1) frees them all. Unlike with front(), the element
+     * may be moved from; release() destroys it either way.
+     *
+     * @param pending Number of elements acquired since the last release()
+     * @return Pointer to the element, or nullptr if the buffer holds no more
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] T* try_acquire(size_type pending) noexcept {
+        const auto position = advance(head_.load(std::memory_order_relaxed), pending);
+        if (is_drained(position)) {
+            consumer_stats_.empty();
+            return nullptr;
+        }
+        prefetch_ahead<false>(position, 1);
+        return slot_ptr(slot_of(position));
+    }
+
+    /**
+     * @brief Remove the element returned by front()
+     *
+     * @warning The buffer must not be empty.
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    void pop_front() noexcept {
+        release(1);
+    }
+
+    /**
+     * @brief View all currently readable elements in place
+     *
+     * @return The readable elements as up to two segments (empty if the
+     *         buffer is empty). They stay valid until release().
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] Region<const T> read_span() noexcept {
+        static_assert(SlotLayout::kContiguous,
+                      "read_span() needs a contiguous slot layout; use front() and pop_front()");
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        const auto count = readable(current_head, 1);
+        if (count == 0) {
+            consumer_stats_.empty();
+        } else {
+            prefetch_ahead<false>(current_head, count);
+        }
+        const auto start = slot_of(current_head);
+        const auto first_run = std::min(count, slot_count() - start);
+        return {{slot_ptr(start), first_run}, {slot_ptr(0), count - first_run}};
+    }
+
+    /**
+     * @brief Remove the oldest n elements after reading them in place
+     *
+     * The elements are destroyed before their slots are handed back to the
+     * producer.
+     *
+     * @param n Number of elements to remove
+     *
+     * @warning n must not exceed the size of the last read_span(), or the
+     *          number of elements acquired since the last release().
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    void release(size_type n) noexcept {
+        const auto current_head = head_.load(std::memory_order_relaxed);
+        destroy_range(current_head, n);
+        publish_head(advance(current_head, n));
+        if (n != 0) {
+            consumer_stats_.popped(n);
+        }
+    }
+
+    /**
+     * @brief Check if the buffer appears empty
+     *
+     * @return true if the buffer appears empty at the time of the call
+     *
+     * @note This is an approximate check. The state may change immediately
+     *       after this function returns due to concurrent operations.
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.load(std::memory_order_relaxed) ==
+               tail_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Check if the buffer appears full
+     *
+     * @return true if the buffer appears full at the time of the call
+     *
+     * @note This is an approximate check. The state may change immediately
+     *       after this function returns due to concurrent operations.
+     */
+    [[nodiscard]] bool full() const noexcept {
+        return size() == usable_slots();
+    }
+
+    /**
+     * @brief Get the approximate current size
+     *
+     * @return The approximate number of elements currently in the buffer
+     *
+     * @note This is an approximate value. The actual size may change
+     *       immediately after this function returns due to concurrent operations.
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        const auto head = head_.load(std::memory_order_relaxed);
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        // With free-running indices the two loads can straddle a pop and a
+        // push, so clamp the snapshot to what the buffer can actually hold.
+        return std::min(distance(head, tail), usable_slots());
+    }
+
+    /**
+     * @brief Get a snapshot of the hot-path counters
+     *
+     * @return The counters recorded by Traits::Stats; all zero with NoStats
+     *
+     * @note May be called from any thread, e.g. a monitoring thread. Each
+     *       counter is read atomically, but they are not read at one instant.
+     */
+    [[nodiscard]] RingBufferStats stats() const noexcept {
+        RingBufferStats result;
+        producer_stats_.snapshot(result);
+        consumer_stats_.snapshot(result);
+        return result;
+    }
+
+    /**
+     * @brief Descriptor that polls readable once data arrives
+     *
+     * Requires a pollable Traits::WaitPolicy such as EventFdWait. Register it
+     * (level-triggered) with epoll or io_uring next to the consumer's other
+     * descriptors. Before sleeping, drain the buffer and call
+     * arm_notification(); once the descriptor is reported readable, call
+     * clear_notification() and drain again. The buffer owns the descriptor.
+     *
+     * @note May be called from any thread
+     */
+    [[nodiscard]] int notification_fd() const noexcept {
+        static_assert(kPollableWait, "notification_fd() requires a pollable wait policy such as EventFdWait");
+        return not_empty_.fd();
+    }
+
+    /**
+     * @brief Ask the producer to signal notification_fd() on its next push
+     *
+     * @return true if the buffer is still empty and the caller may sleep on
+     *         the descriptor, false if data arrived meanwhile (drain instead)
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] bool arm_notification() noexcept {
+        static_assert(kPollableWait, "arm_notification() requires a pollable wait policy such as EventFdWait");
+        not_empty_.arm();
+        if (is_drained(head_.load(std::memory_order_relaxed))) {
+            return true;
+        }
+        not_empty_.disarm();
+        return false;
+    }
+
+    /**
+     * @brief Consume the signal that made notification_fd() readable
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    void clear_notification() noexcept {
+        static_assert(kPollableWait, "clear_notification() requires a pollable wait policy such as EventFdWait");
+        not_empty_.clear();
+    }
+
+protected:
+    /// Slot storage type the derived class must provide
+    using slot_type = typename SlotLayout::slot_type;
+
+    /// Fewest slots the layout supports; derived classes must enforce it
+    static constexpr std::size_t kMinSlots = SlotLayout::kMinSlots;
+
+    // User-provided (rather than defaulted) so that value-initialization of
+    // a derived buffer does not zero its slot storage.
+    RingBufferCore() noexcept(std::is_nothrow_default_constructible_v<WaitState>) {}
+    ~RingBufferCore() = default;
+
+    // Non-copyable and non-movable for safety
+    RingBufferCore(const RingBufferCore&) = delete;
+    RingBufferCore& operator=(const RingBufferCore&) = delete;
+    RingBufferCore(RingBufferCore&&) = delete;
+    RingBufferCore& operator=(RingBufferCore&&) = delete;
+
+    /**
+     * Destroy the elements still in the buffer. Must not run concurrently
+     * with producer or consumer operations.
+     */
+    void destroy_all() noexcept {
+        const auto head = head_.load(std::memory_order_acquire);
+        destroy_range(head, distance(head, tail_.load(std::memory_order_acquire)));
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lock-free single-producer single-consumer ring buffer
+ *
+ * A high-performance circular queue optimized for scenarios where exactly one thread
+ * produces data and exactly one thread consumes data. Provides wait-free operations
+ * with zero memory allocation after construction.
+ *
+ * Key features:
+ * - Lock-free and wait-free operations
+ * - Cache-optimized with cache-line alignment (64 bytes by default)
+ * - Cached opposite indices to avoid cross-core cache line ping-pong
+ * - Zero memory allocation after construction
+ * - Type-safe with move semantics support
+ * - Bulk push/pop that publish the index once per batch
+ * - Zero-copy reserve/commit and peek/release access to slots
+ * - Uninitialized slot storage: elements are constructed on push and
+ *   destroyed on pop, so T need not be default-constructible
+ * - Capacity must be a power of 2 for optimal performance
+ * - Actual storage capacity is Capacity-1 items (Capacity with
+ *   RingBufferTraits::kFreeRunningIndices)
+ *
+ * @tparam T The type of elements stored in the ring buffer
+ * @tparam Capacity The maximum number of elements (must be power of 2)
+ * @tparam Traits Compile-time tuning options, see RingBufferTraits
+ *
+ * @note By default this implementation keeps one slot empty to distinguish
+ *       between empty and full states, so effective capacity is Capacity-1.
+ *       Enable RingBufferTraits::kFreeRunningIndices to use every slot.
+ *
+ * @warning This class is NOT thread-safe for multiple producers or consumers.
+ *          Use MpscRingBuffer or SpmcRingBuffer (sequenced_ring_buffer.hpp)
+ *          for such cases.
+ *
+ * Example usage:
+ * @code
+ * #include <lockfree/ring_buffer.hpp>
+ *
+ * lockfree::RingBuffer<int, 1024> buffer;
+ *
+ * // Producer thread
+ * if (buffer.try_push(42)) {
+ *     // Success
+ * }
+ *
+ * // Consumer thread
+ * if (auto item = buffer.try_pop()) {
+ *     // Process *item
+ * }
+ * @endcode
+ */
+template <typename T, std::size_t Capacity, typename Traits = RingBufferTraits>
+class RingBuffer
+    : public detail::RingBufferCore<RingBuffer<T, Capacity, Traits>, T, Traits> {
+    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 1,
+                  "Capacity must be a power of 2 and greater than 1");
+
+    using Core = detail::RingBufferCore<RingBuffer, T, Traits>;
+    friend Core;
+
+    static_assert(Capacity >= Core::kMinSlots,
+                  "Capacity is too small for the slot layout (ScrambledLayout needs 2^(2b) slots)");
+
+    // Data storage aligned to cache line boundary. Left uninitialized: only
+    // slots between head and tail hold live objects.
+    alignas(Traits::kCacheLineSize) typename Core::slot_type slots_[Capacity];
+
+    [[nodiscard]] static constexpr std::size_t index_mask() noexcept {
+        return Capacity - 1;
+    }
+
+    [[nodiscard]] typename Core::slot_type* slot_data() noexcept {
+        return slots_;
+    }
+
+public:
+    using typename Core::value_type;
+    using typename Core::size_type;
+
+    /**
+     * @brief Default constructor
+     *
+     * Constructs an empty ring buffer. The slot storage is left
+     * uninitialized, so no element is constructed and the storage pages are
+     * not touched until they are first used.
+     *
+     * @throws std::system_error if the wait policy cannot create its
+     *         descriptors (EventFdWait only)
+     */
+    RingBuffer() noexcept(std::is_nothrow_default_constructible_v<typename Traits::WaitPolicy::State>) {}
+
+    /**
+     * @brief Destructor
+     *
+     * Destroys the elements still in the buffer. Must not run concurrently
+     * with producer or consumer operations.
+     */
+    ~RingBuffer() {
+        this->destroy_all();
     }
 
     /**
@@ -252,11 +1460,12 @@ public:
      *
      * @return The maximum number of elements this buffer can hold
      *
-     * @note Due to the implementation keeping one slot empty, this returns
-     *       Capacity - 1, which is the actual usable capacity.
+     * @note By default the implementation keeps one slot empty, so this
+     *       returns Capacity - 1, which is the actual usable capacity. With
+     *       RingBufferTraits::kFreeRunningIndices it returns Capacity.
      */
     [[nodiscard]] static constexpr size_type capacity() noexcept {
-        return Capacity - 1;  // One slot kept empty for empty/full distinction
+        return Traits::kFreeRunningIndices ? Capacity : Capacity - 1;
     }
 
     /**
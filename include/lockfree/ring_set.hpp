@@ -0,0 +1,404 @@
+/**
+ * @file ring_set.hpp
+ * @brief One consumer polling many SPSC ring buffers through a doorbell bitmap
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace lockfree {
+
+namespace detail {
+
+/// Index of the lowest set bit; bits must not be zero
+[[nodiscard]] inline unsigned lowest_set_bit(std::uint64_t bits) noexcept {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief A fixed set of SPSC rings, one per producer, drained by one consumer
+ *
+ * Giving every producer its own RingBuffer avoids the contended index of an
+ * MPSC queue, but a consumer that polls N rings reads N remote tail_ lines per
+ * pass even when only one ring has data. RingSet keeps a doorbell bitmap next
+ * to the rings: a producer sets its ring's bit when it finds it clear after a
+ * push, and the consumer only visits rings whose bit is set, clearing the bit
+ * once it has drained the ring.
+ *
+ * Producers set a bit only when it is clear, so while the consumer is busy the
+ * doorbell line stays shared and a push costs one local fence and one load.
+ * A ring that is drained and rung again costs one RMW on each side.
+ *
+ * Rings are served round-robin, starting after the last ring served, and
+ * each visit drains at most max_per_ring elements so that a busy producer
+ * cannot starve the others.
+ *
+ * @tparam T Type of elements stored in the rings
+ * @tparam Capacity Buffer size of each ring (must be a power of 2)
+ * @tparam Rings Number of rings, i.e. the maximum number of producers
+ * @tparam Traits Compile-time tuning knobs for every ring
+ *
+ * Example usage:
+ * @code
+ * auto ingest = std::make_unique<lockfree::RingSet<Packet, 1024, 64>>();
+ *
+ * // Producer k, on its own core
+ * auto producer = ingest->producer(k);
+ * producer.push(packet);
+ *
+ * // The single consumer
+ * ingest->poll([](std::size_t ring, const Packet& packet) { route(ring, packet); });
+ * @endcode
+ *
+ * @note Each ring is SPSC: at most one thread may use the Producer handle of
+ *       a given ring at a time, and only one thread may poll.
+ */
+template <typename T, std::size_t Capacity, std::size_t Rings, typename Traits = RingBufferTraits>
+class RingSet {
+    static_assert(Rings > 0, "A RingSet needs at least one ring");
+
+public:
+    using ring_type = RingBuffer<T, Capacity, Traits>;
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Default number of elements drained from one ring per visit
+    static constexpr size_type kDefaultBatch = 64;
+
+private:
+    static constexpr size_type kBitsPerWord = 64;
+    static constexpr size_type kWords = (Rings + kBitsPerWord - 1) / kBitsPerWord;
+
+    /// Whether the rings' slots can be read in place through read_span()
+    static constexpr bool kContiguousSlots =
+        Traits::Layout::template Slots<T, Traits::kCacheLineSize>::kContiguous;
+
+    // One line per doorbell word, so at most 64 producers share a line
+    struct alignas(detail::kCacheLineSize) Doorbell {
+        std::atomic<std::uint64_t> bits{0};
+    };
+
+    Doorbell doorbells_[kWords];
+    alignas(detail::kCacheLineSize) size_type cursor_{0};  ///< Consumer's next ring to serve
+    ring_type rings_[Rings];
+
+    [[nodiscard]] static constexpr std::uint64_t bit_of(size_type ring) noexcept {
+        return std::uint64_t{1} << (ring % kBitsPerWord);
+    }
+
+    [[nodiscard]] std::atomic<std::uint64_t>& doorbell_of(size_type ring) noexcept {
+        return doorbells_[ring / kBitsPerWord].bits;
+    }
+
+    /**
+     * Consumer side, after a ring was seen drained: clear its bit, then look
+     * at the ring again. Paired with the fence in Producer::ring_doorbell(),
+     * either the producer sees the cleared bit and sets it again, or we see
+     * its element here and set the bit back ourselves.
+     */
+    void quiesce(size_type ring) noexcept {
+        auto& doorbell = doorbell_of(ring);
+        doorbell.fetch_and(~bit_of(ring), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!rings_[ring].empty()) {
+            doorbell.fetch_or(bit_of(ring), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Visit every ring whose bit is set, in round-robin order starting at
+     * cursor_, until visit(ring) returns true. Returns whether it did.
+     */
+    template <typename Visit>
+    bool scan(Visit&& visit) {
+        const size_type start_word = cursor_ / kBitsPerWord;
+        const size_type start_bit = cursor_ % kBitsPerWord;
+        // The starting word is scanned twice: bits at or above the cursor
+        // first, and the bits below it after wrapping around.
+        for (size_type step = 0; step <= kWords; ++step) {
+            const size_type word = (start_word + step) % kWords;
+            auto bits = doorbells_[word].bits.load(std::memory_order_relaxed);
+            if (step == 0) {
+                bits &= ~std::uint64_t{0} << start_bit;
+            } else if (step == kWords) {
+                bits &= (std::uint64_t{1} << start_bit) - 1;
+            }
+            while (bits != 0) {
+                const size_type ring = word * kBitsPerWord + detail::lowest_set_bit(bits);
+                bits &= bits - 1;
+                cursor_ = ring + 1 == Rings ? 0 : ring + 1;
+                if (visit(ring)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Hand up to max elements of one ring to handler, then release them
+    template <typename Handler>
+    size_type drain(size_type ring, Handler& handler, size_type max) {
+        auto& buffer = rings_[ring];
+        size_type batch = 0;
+        size_type handled = 0;
+        try {
+            if constexpr (kContiguousSlots) {
+                const auto region = buffer.read_span();
+                batch = std::min(region.size(), max);
+                const auto first_run = std::min(batch, region.first.size);
+                for (; handled < first_run; ++handled) {
+                    handler(ring, region.first[handled]);
+                }
+                for (; handled < batch; ++handled) {
+                    handler(ring, region.second[handled - first_run]);
+                }
+            } else {
+                // Padded or scrambled slots are not adjacent, so walk them one at a time
+                for (; handled < max; ++handled) {
+                    const T* element = buffer.try_acquire(handled);
+                    if (element == nullptr) {
+                        break;
+                    }
+                    handler(ring, *element);
+                }
+                batch = handled;
+            }
+        } catch (...) {
+            // The element that threw counts as delivered, like the ones before it
+            buffer.release(handled + 1);
+            throw;
+        }
+        buffer.release(batch);
+        if (batch < max) {
+            quiesce(ring);
+        }
+        return batch;
+    }
+
+public:
+    /**
+     * @brief Producer handle for one ring of the set
+     *
+     * Pushes go to the ring, followed by a doorbell check. The handle is
+     * cheap to copy but must not be used by two threads at once.
+     */
+    class Producer {
+        friend RingSet;
+
+        ring_type* ring_;
+        std::atomic<std::uint64_t>* doorbell_;
+        std::uint64_t bit_;
+
+        Producer(ring_type& ring, std::atomic<std::uint64_t>& doorbell, std::uint64_t bit) noexcept
+            : ring_(&ring), doorbell_(&doorbell), bit_(bit) {}
+
+        /**
+         * Set this ring's bit unless it already is. The fence orders the
+         * element's publication before the doorbell load, so a consumer
+         * that cleared the bit concurrently is sure to see either the bit
+         * or the element (see RingSet::quiesce()).
+         */
+        void ring_doorbell() noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if ((doorbell_->load(std::memory_order_relaxed) & bit_) == 0) {
+                doorbell_->fetch_or(bit_, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        /**
+         * @brief Attempt to push an element
+         *
+         * @return true if the element was added, false if the ring is full
+         */
+        [[nodiscard]] bool try_push(const T& item) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            return try_emplace(item);
+        }
+
+        /**
+         * @brief Attempt to push an element (move version)
+         *
+         * @return true if the element was added, false if the ring is full
+         */
+        [[nodiscard]] bool try_push(T&& item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            return try_emplace(std::move(item));
+        }
+
+        /**
+         * @brief Attempt to construct an element in place
+         *
+         * @return true if the element was added, false if the ring is full
+         */
+        template <typename... Args>
+        [[nodiscard]] bool try_emplace(Args&&... args)
+            noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+            if (!ring_->try_emplace(std::forward<Args>(args)...)) {
+                return false;
+            }
+            ring_doorbell();
+            return true;
+        }
+
+        /**
+         * @brief Push as many elements as fit, ringing the doorbell once
+         *
+         * @return Number of elements pushed
+         */
+        [[nodiscard]] size_type try_push_n(const T* first, size_type n)
+            noexcept(std::is_nothrow_copy_constructible_v<T>) {
+            const auto pushed = ring_->try_push_n(first, n);
+            if (pushed != 0) {
+                ring_doorbell();
+            }
+            return pushed;
+        }
+
+        /**
+         * @brief Push an element, waiting for space if the ring is full
+         */
+        void push(const T& item) {
+            ring_->push(item);
+            ring_doorbell();
+        }
+
+        /**
+         * @brief Push an element (move version), waiting for space if the ring is full
+         */
+        void push(T&& item) {
+            ring_->push(std::move(item));
+            ring_doorbell();
+        }
+
+        /**
+         * @brief Construct an element in place, waiting for space if the ring is full
+         */
+        template <typename... Args>
+        void emplace(Args&&... args) {
+            ring_->emplace(std::forward<Args>(args)...);
+            ring_doorbell();
+        }
+    };
+
+    /**
+     * @brief Default constructor; all rings start empty
+     */
+    RingSet() noexcept = default;
+
+    RingSet(const RingSet&) = delete;
+    RingSet& operator=(const RingSet&) = delete;
+    RingSet(RingSet&&) = delete;
+    RingSet& operator=(RingSet&&) = delete;
+
+    /**
+     * @brief Get the producer handle of one ring
+     *
+     * @param ring Ring index in [0, ring_count())
+     * @throws std::out_of_range if ring is not a valid index
+     */
+    [[nodiscard]] Producer producer(size_type ring) {
+        if (ring >= Rings) {
+            throw std::out_of_range("RingSet::producer: ring index out of range");
+        }
+        return Producer(rings_[ring], doorbell_of(ring), bit_of(ring));
+    }
+
+    /**
+     * @brief Drain the rings that have data
+     *
+     * Calls handler(ring_index, const T& element) for up to max_per_ring
+     * elements of every ring whose doorbell is set. Rings are visited
+     * round-robin; each ring's elements arrive in push order.
+     *
+     * @param handler Called with the ring index and each element, which stays
+     *                valid only for the duration of the call
+     * @param max_per_ring Maximum number of elements taken from one ring
+     * @return Number of elements handled
+     *
+     * @note If handler throws, the element it threw on and those before it
+     *       are removed, and the exception propagates.
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    template <typename Handler>
+    size_type poll(Handler&& handler, size_type max_per_ring = kDefaultBatch) {
+        size_type handled = 0;
+        scan([&](size_type ring) {
+            handled += drain(ring, handler, max_per_ring);
+            return false;
+        });
+        return handled;
+    }
+
+    /**
+     * @brief Pop one element from the next ring with data
+     *
+     * @return The element, or std::nullopt if no ring has data
+     *
+     * @note This function should only be called from the consumer thread
+     */
+    [[nodiscard]] std::optional<T> try_pop() noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::optional<T> result;
+        scan([&](size_type ring) {
+            result = rings_[ring].try_pop();
+            if (!result) {
+                quiesce(ring);
+            }
+            return result.has_value();
+        });
+        return result;
+    }
+
+    /**
+     * @brief Check whether any ring has rung its doorbell
+     *
+     * @note This is an approximate check: a bit may still be set for a ring
+     *       the consumer has just drained.
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return std::all_of(std::begin(doorbells_), std::end(doorbells_), [](const Doorbell& doorbell) {
+            return doorbell.bits.load(std::memory_order_relaxed) == 0;
+        });
+    }
+
+    /**
+     * @brief Get the number of rings in the set
+     */
+    [[nodiscard]] static constexpr size_type ring_count() noexcept {
+        return Rings;
+    }
+
+    /**
+     * @brief Get the number of elements each ring can hold
+     */
+    [[nodiscard]] static constexpr size_type ring_capacity() noexcept {
+        return ring_type::capacity();
+    }
+};
+
+} // namespace lockfree
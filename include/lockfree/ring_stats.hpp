@@ -0,0 +1,179 @@
+/**
+ * @file ring_stats.hpp
+ * @brief Compile-time opt-in counters for the ring buffer hot paths
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace lockfree {
+
+/*
+ * A stats policy tells the ring buffer what to record on its hot paths. Every
+ * policy provides:
+ *
+ *   static constexpr bool kEnabled;
+ *   struct Producer;   // embedded next to the producer's index
+ *   struct Consumer;   // embedded next to the consumer's index
+ *
+ * with
+ *
+ *   void Producer::pushed(std::size_t count, std::size_t occupancy) noexcept;
+ *   void Producer::full() noexcept;
+ *   void Consumer::popped(std::size_t count) noexcept;
+ *   void Consumer::empty() noexcept;
+ *   void Producer::snapshot(RingBufferStats&) const noexcept;  // any thread
+ *   void Consumer::snapshot(RingBufferStats&) const noexcept;  // any thread
+ *
+ * Each side's counters follow the index that side already writes on every
+ * operation. They may spill over several cache lines, but only that side
+ * writes those lines, so recording them adds no coherence traffic.
+ */
+
+/**
+ * @brief Snapshot of a ring buffer's counters, returned by stats()
+ *
+ * All fields are zero when the ring's stats policy is NoStats.
+ */
+struct RingBufferStats {
+    /// Number of batch-size buckets; bucket i counts calls moving [2^i, 2^(i+1)) elements
+    static constexpr std::size_t kBatchBuckets = 16;
+
+    std::uint64_t pushed = 0;          ///< Elements published by the producer
+    std::uint64_t push_full = 0;       ///< Non-blocking push/reserve attempts that found the buffer full
+    std::uint64_t popped = 0;          ///< Elements removed by the consumer
+    std::uint64_t pop_empty = 0;       ///< Non-blocking pop/peek attempts that found the buffer empty
+    std::uint64_t peak_occupancy = 0;  ///< Highest occupancy seen by the producer after a push
+    std::array<std::uint64_t, kBatchBuckets> push_batches{};  ///< Distribution of elements per publish
+    std::array<std::uint64_t, kBatchBuckets> pop_batches{};   ///< Distribution of elements per release
+};
+
+namespace detail {
+
+/// Batch-size bucket of count (count must not be zero): floor(log2(count)), capped
+[[nodiscard]] inline std::size_t batch_bucket(std::size_t count) noexcept {
+    std::size_t bucket = 0;
+    while (count > 1 && bucket + 1 < RingBufferStats::kBatchBuckets) {
+        count >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+/**
+ * Counter written by a single thread and read by any thread. The update is a
+ * relaxed load and store rather than a read-modify-write, so it compiles to a
+ * plain increment, while concurrent snapshots stay free of data races.
+ */
+class OwnedCounter {
+    std::atomic<std::uint64_t> value_{0};
+
+public:
+    void add(std::uint64_t n) noexcept {
+        value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void raise_to(std::uint64_t n) noexcept {
+        if (n > value_.load(std::memory_order_relaxed)) {
+            value_.store(n, std::memory_order_relaxed);
+        }
+    }
+
+    [[nodiscard]] std::uint64_t get() const noexcept {
+        return value_.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Record nothing (default)
+ *
+ * All hooks are empty and stats() returns zeros, so the hot paths compile
+ * exactly as without instrumentation.
+ */
+struct NoStats {
+    static constexpr bool kEnabled = false;
+
+    struct Producer {
+        void pushed(std::size_t, std::size_t) noexcept {}
+        void full() noexcept {}
+        void snapshot(RingBufferStats&) const noexcept {}
+    };
+
+    struct Consumer {
+        void popped(std::size_t) noexcept {}
+        void empty() noexcept {}
+        void snapshot(RingBufferStats&) const noexcept {}
+    };
+};
+
+/**
+ * @brief Count operations, failures, peak occupancy and batch sizes
+ *
+ * Costs a few plain increments per operation on lines the calling side
+ * already owns. stats() may be called from any thread, e.g. a monitoring
+ * thread; each counter is read atomically, but the snapshot as a whole is
+ * not taken at a single instant.
+ */
+struct CountingStats {
+    static constexpr bool kEnabled = true;
+
+    struct Producer {
+        detail::OwnedCounter pushed_;
+        detail::OwnedCounter full_;
+        detail::OwnedCounter peak_occupancy_;
+        detail::OwnedCounter batches_[RingBufferStats::kBatchBuckets];
+
+        void pushed(std::size_t count, std::size_t occupancy) noexcept {
+            pushed_.add(count);
+            peak_occupancy_.raise_to(occupancy);
+            batches_[detail::batch_bucket(count)].add(1);
+        }
+
+        void full() noexcept {
+            full_.add(1);
+        }
+
+        void snapshot(RingBufferStats& stats) const noexcept {
+            stats.pushed = pushed_.get();
+            stats.push_full = full_.get();
+            stats.peak_occupancy = peak_occupancy_.get();
+            for (std::size_t i = 0; i < RingBufferStats::kBatchBuckets; ++i) {
+                stats.push_batches[i] = batches_[i].get();
+            }
+        }
+    };
+
+    struct Consumer {
+        detail::OwnedCounter popped_;
+        detail::OwnedCounter empty_;
+        detail::OwnedCounter batches_[RingBufferStats::kBatchBuckets];
+
+        void popped(std::size_t count) noexcept {
+            popped_.add(count);
+            batches_[detail::batch_bucket(count)].add(1);
+        }
+
+        void empty() noexcept {
+            empty_.add(1);
+        }
+
+        void snapshot(RingBufferStats& stats) const noexcept {
+            stats.popped = popped_.get();
+            stats.pop_empty = empty_.get();
+            for (std::size_t i = 0; i < RingBufferStats::kBatchBuckets; ++i) {
+                stats.pop_batches[i] = batches_[i].get();
+            }
+        }
+    };
+};
+
+} // namespace lockfree
@@ -0,0 +1,95 @@
+/**
+ * @file seqlock.hpp
+ * @brief Version-stamped slots for rings whose producer overwrites unread data
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+namespace detail {
+
+/**
+ * Copy between seqlock-protected slots. The reader's copy may race with the
+ * producer's next write of the same slot and is discarded if the version moved,
+ * so both sides copy with relaxed atomic accesses (word-sized when T allows)
+ * to keep that race well-defined and invisible to ThreadSanitizer.
+ */
+template <typename T>
+inline void seqlock_copy(unsigned char* dst, const unsigned char* src) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (alignof(T) >= sizeof(std::uint64_t) && sizeof(T) % sizeof(std::uint64_t) == 0) {
+        auto* out = reinterpret_cast<std::uint64_t*>(dst);
+        const auto* in = reinterpret_cast<const std::uint64_t*>(src);
+        for (std::size_t i = 0; i < sizeof(T) / sizeof(std::uint64_t); ++i) {
+            __atomic_store_n(out + i, __atomic_load_n(in + i, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+        }
+    } else {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            __atomic_store_n(dst + i, __atomic_load_n(src + i, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+        }
+    }
+#else
+    std::memcpy(dst, src, sizeof(T));
+#endif
+}
+
+/**
+ * @brief Slot whose element may be overwritten while a reader copies it
+ *
+ * The version is 2 * position + 1 while the element for a ring position is
+ * being written and 2 * position + 2 once it is complete. A reader checks the
+ * version before and after its copy, so it either gets the element for the
+ * position it asked for, whole, or learns that the slot has moved on.
+ */
+template <typename T>
+struct VersionedSlot {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Versioned slots are copied while they may be overwritten, so T must be trivially copyable");
+
+    std::atomic<std::size_t> version{0};
+    Slot<T> storage;
+
+    /// Write the element for position (single writer only)
+    template <typename... Args>
+    void store(std::size_t position, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        // Build first so a throwing constructor never leaves a half-written slot
+        Slot<T> item;
+        ::new (static_cast<void*>(item.bytes)) T(std::forward<Args>(args)...);
+        version.store(2 * position + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        seqlock_copy<T>(storage.bytes, item.bytes);
+        version.store(2 * position + 2, std::memory_order_release);
+    }
+
+    /// Copy the element for position into out; false if the slot holds another position
+    [[nodiscard]] bool load(std::size_t position, Slot<T>& out) const noexcept {
+        const auto expected = 2 * position + 2;
+        if (version.load(std::memory_order_acquire) != expected) {
+            return false;
+        }
+        seqlock_copy<T>(out.bytes, storage.bytes);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return version.load(std::memory_order_relaxed) == expected;
+    }
+
+    /// The element previously copied out by load()
+    [[nodiscard]] static T& element(Slot<T>& copy) noexcept {
+        return *std::launder(reinterpret_cast<T*>(copy.bytes));
+    }
+};
+
+} // namespace detail
+} // namespace lockfree
@@ -0,0 +1,477 @@
+/**
+ * @file sequenced_ring_buffer.hpp
+ * @brief Lock-free MPSC and SPMC ring buffers with per-slot sequence numbers
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "ring_buffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+
+namespace detail {
+
+/**
+ * @brief Bounded ring buffer with a sequence number per slot (Vyukov-style)
+ *
+ * Each slot's sequence says whose turn it is: a slot at position pos is free
+ * for the producer of pos when its sequence equals pos, and holds the element
+ * for the consumer of pos when it equals pos + 1. Releasing a slot sets it to
+ * pos + Capacity, the turn of the producer one lap later.
+ *
+ * A side with several threads claims positions on its shared index: try_*
+ * operations with a compare-exchange (so they never claim a slot they cannot
+ * use), blocking operations with a single fetch_add followed by a wait for
+ * the slot's turn. A side with a single thread uses plain loads and stores.
+ *
+ * @tparam kMultiProducer Whether several threads may push concurrently
+ * @tparam kMultiConsumer Whether several threads may pop concurrently
+ */
+template <typename T, std::size_t Capacity, typename Traits, bool kMultiProducer, bool kMultiConsumer>
+class SequencedRingBuffer {
+    static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 1,
+                  "Capacity must be a power of 2 and greater than 1");
+    static_assert(std::is_move_constructible_v<T>,
+                  "T must be move constructible");
+    static_assert(std::is_nothrow_destructible_v<T>,
+                  "T must be nothrow destructible");
+    // A claimed slot must always be handed on, or the other side waits forever
+    static_assert(!kMultiConsumer || std::is_nothrow_move_constructible_v<T>,
+                  "Multi-consumer rings require a nothrow move constructor");
+    static_assert(std::is_empty_v<typename Traits::WaitPolicy::State>,
+                  "Sequenced rings support spinning wait policies only (not SpinSleepWait)");
+
+    using WaitPolicy = typename Traits::WaitPolicy;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Slot<T> storage;
+    };
+
+    static constexpr std::size_t kIndexMask = Capacity - 1;
+
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};  ///< Next position to pop
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};  ///< Next position to push
+    alignas(kCacheLineSize) Cell cells_[Capacity];
+
+    [[nodiscard]] Cell& cell(std::size_t position) noexcept {
+        return cells_[position & kIndexMask];
+    }
+
+    [[nodiscard]] static T* element(Cell& slot) noexcept {
+        return std::launder(reinterpret_cast<T*>(slot.storage.bytes));
+    }
+
+    /// Signed distance between a slot's sequence and the expected value
+    [[nodiscard]] static std::intptr_t lag(std::size_t sequence, std::size_t expected) noexcept {
+        return static_cast<std::intptr_t>(sequence - expected);
+    }
+
+    template <typename Ready>
+    static void wait_until(Ready&& ready) {
+        typename WaitPolicy::State state;
+        WaitPolicy::wait(state, ready, NoDeadline{});
+    }
+
+    /**
+     * Claim up to max consecutive positions whose slots are in the wanted
+     * turn (offset 0: free for producers, 1: full for consumers).
+     * Returns the first claimed position and sets count (0 if none ready).
+     * A shared index is advanced here; a single-threaded side advances its
+     * own index once the slots have been handed on.
+     */
+    template <bool kShared>
+    [[nodiscard]] std::size_t claim(std::atomic<std::size_t>& index, std::size_t offset,
+                                    std::size_t max, std::size_t& count) noexcept {
+        auto position = index.load(std::memory_order_relaxed);
+        while (true) {
+            std::size_t ready = 0;
+            while (ready < max &&
+                   cell(position + ready).sequence.load(std::memory_order_acquire) == position + ready + offset) {
+                ++ready;
+            }
+            if (ready == 0) {
+                if constexpr (kShared) {
+                    const auto sequence = cell(position).sequence.load(std::memory_order_acquire);
+                    if (lag(sequence, position + offset) > 0) {
+                        // Another thread claimed this position; retry from the new index
+                        position = index.load(std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+                count = 0;
+                return position;
+            }
+            if constexpr (kShared) {
+                if (!index.compare_exchange_weak(position, position + ready, std::memory_order_relaxed)) {
+                    continue;
+                }
+            }
+            count = ready;
+            return position;
+        }
+    }
+
+    /// Move the element at position out into out and hand the slot back to producers
+    template <typename Out>
+    void consume(std::size_t position, Out&& out) {
+        Cell& slot = cell(position);
+        T* item = element(slot);
+        out(std::move(*item));
+        item->~T();
+        slot.sequence.store(position + Capacity, std::memory_order_release);
+    }
+
+    /// Claim one free slot and construct the element in it
+    template <typename... Args>
+    [[nodiscard]] bool emplace_claimed(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        std::size_t count;
+        const auto position = claim<kMultiProducer>(tail_, 0, 1, count);
+        if (count == 0) {
+            return false;
+        }
+        Cell& slot = cell(position);
+        ::new (static_cast<void*>(slot.storage.bytes)) T(std::forward<Args>(args)...);
+        if constexpr (!kMultiProducer) {
+            tail_.store(position + 1, std::memory_order_relaxed);
+        }
+        slot.sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Claim the next position with fetch_add (or a plain load) and wait for its slot
+    template <typename... Args>
+    void wait_and_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        std::size_t position;
+        if constexpr (kMultiProducer) {
+            position = tail_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+        Cell& slot = cell(position);
+        wait_until([&] { return slot.sequence.load(std::memory_order_acquire) == position; });
+        ::new (static_cast<void*>(slot.storage.bytes)) T(std::forward<Args>(args)...);
+        if constexpr (!kMultiProducer) {
+            tail_.store(position + 1, std::memory_order_relaxed);
+        }
+        slot.sequence.store(position + 1, std::memory_order_release);
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /**
+     * @brief Default constructor
+     *
+     * Initializes the slot sequences; the element storage is left
+     * uninitialized.
+     */
+    SequencedRingBuffer() noexcept {
+        for (std::size_t i = 0; i < Capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    SequencedRingBuffer(const SequencedRingBuffer&) = delete;
+    SequencedRingBuffer& operator=(const SequencedRingBuffer&) = delete;
+    SequencedRingBuffer(SequencedRingBuffer&&) = delete;
+    SequencedRingBuffer& operator=(SequencedRingBuffer&&) = delete;
+
+    /**
+     * @brief Destructor
+     *
+     * Destroys the elements still in the buffer. Must not run concurrently
+     * with producer or consumer operations.
+     */
+    ~SequencedRingBuffer() {
+        const auto tail = tail_.load(std::memory_order_acquire);
+        for (auto position = head_.load(std::memory_order_relaxed); position != tail; ++position) {
+            Cell& slot = cell(position);
+            if (slot.sequence.load(std::memory_order_acquire) == position + 1) {
+                element(slot)->~T();
+            }
+        }
+    }
+
+    /**
+     * @brief Attempt to construct an element in place
+     *
+     * @return true if successful, false if the buffer is full
+     */
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        if constexpr (kMultiProducer && !std::is_nothrow_constructible_v<T, Args&&...>) {
+            // A claimed slot must be filled, so build the element first and
+            // move it in with the nothrow move constructor
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                          "Multi-producer rings require nothrow construction or a nothrow move constructor");
+            T item(std::forward<Args>(args)...);
+            return try_emplace(std::move(item));
+        } else {
+            return emplace_claimed(std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Attempt to push an element (copy version)
+     *
+     * @return true if successful, false if the buffer is full
+     */
+    [[nodiscard]] bool try_push(const T& item) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return try_emplace(item);
+    }
+
+    /**
+     * @brief Attempt to push an element (move version)
+     *
+     * @return true if successful, false if the buffer is full
+     */
+    [[nodiscard]] bool try_push(T&& item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return try_emplace(std::move(item));
+    }
+
+    /**
+     * @brief Attempt to pop an element
+     *
+     * @return The element if available, std::nullopt if the buffer is empty
+     */
+    [[nodiscard]] std::optional<T> try_pop() noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::size_t count;
+        const auto position = claim<kMultiConsumer>(head_, 1, 1, count);
+        if (count == 0) {
+            return std::nullopt;
+        }
+        std::optional<T> result;
+        consume(position, [&result](T&& item) { result.emplace(std::move(item)); });
+        if constexpr (!kMultiConsumer) {
+            head_.store(position + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Construct an element in place, waiting for a free slot
+     *
+     * On the multi-producer side the position is claimed with a single
+     * fetch_add and the call then waits for that slot's turn.
+     */
+    template <typename... Args>
+    void emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        if constexpr (kMultiProducer && !std::is_nothrow_constructible_v<T, Args&&...>) {
+            static_assert(std::is_nothrow_move_constructible_v<T>,
+                          "Multi-producer rings require nothrow construction or a nothrow move constructor");
+            T item(std::forward<Args>(args)...);
+            emplace(std::move(item));
+        } else {
+            wait_and_emplace(std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Push an element, waiting for a free slot
+     */
+    void push(const T& item) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        emplace(item);
+    }
+
+    /**
+     * @brief Push an element (move version), waiting for a free slot
+     */
+    void push(T&& item) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        emplace(std::move(item));
+    }
+
+    /**
+     * @brief Pop an element, waiting for one
+     *
+     * On the multi-consumer side the position is claimed with a single
+     * fetch_add and the call then waits for that slot to be filled.
+     */
+    [[nodiscard]] T pop() noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::size_t position;
+        if constexpr (kMultiConsumer) {
+            position = head_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+        Cell& slot = cell(position);
+        wait_until([&] { return slot.sequence.load(std::memory_order_acquire) == position + 1; });
+
+        // Single consumer: nothing is claimed until the move succeeded
+        T result(std::move(*element(slot)));
+        element(slot)->~T();
+        if constexpr (!kMultiConsumer) {
+            head_.store(position + 1, std::memory_order_relaxed);
+        }
+        slot.sequence.store(position + Capacity, std::memory_order_release);
+        return result;
+    }
+
+    /**
+     * @brief Attempt to push a contiguous range of elements
+     *
+     * Claims as many consecutive free slots as are available, up to count,
+     * in one step, so the elements of one call stay contiguous and in order
+     * even with other producers running.
+     *
+     * @return Number of elements pushed (0 if the buffer is full)
+     */
+    [[nodiscard]] size_type try_push_n(const T* items, size_type count) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        static_assert(!kMultiProducer || std::is_nothrow_copy_constructible_v<T>,
+                      "Multi-producer rings require nothrow construction (a claimed slot must be filled)");
+        std::size_t claimed;
+        const auto position = claim<kMultiProducer>(tail_, 0, count, claimed);
+        if constexpr (!kMultiProducer) {
+            // Single producer: advance one element at a time so a throwing
+            // copy leaves nothing half-claimed
+            for (std::size_t i = 0; i < claimed; ++i) {
+                Cell& slot = cell(position + i);
+                ::new (static_cast<void*>(slot.storage.bytes)) T(items[i]);
+                tail_.store(position + i + 1, std::memory_order_relaxed);
+                slot.sequence.store(position + i + 1, std::memory_order_release);
+            }
+        } else {
+            for (std::size_t i = 0; i < claimed; ++i) {
+                Cell& slot = cell(position + i);
+                ::new (static_cast<void*>(slot.storage.bytes)) T(items[i]);
+                slot.sequence.store(position + i + 1, std::memory_order_release);
+            }
+        }
+        return claimed;
+    }
+
+    /**
+     * @brief Attempt to pop up to max elements into a contiguous array
+     *
+     * Claims as many consecutive ready elements as are available, up to max,
+     * in one step.
+     *
+     * @return Number of elements popped (0 if the buffer is empty)
+     */
+    [[nodiscard]] size_type try_pop_n(T* out, size_type max) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        static_assert(!kMultiConsumer || std::is_nothrow_move_assignable_v<T>,
+                      "Multi-consumer rings require nothrow move assignment for try_pop_n");
+        if constexpr (kMultiConsumer) {
+            std::size_t claimed;
+            const auto position = claim<true>(head_, 1, max, claimed);
+            for (std::size_t i = 0; i < claimed; ++i) {
+                consume(position + i, [&](T&& item) { out[i] = std::move(item); });
+            }
+            return claimed;
+        } else {
+            // Single consumer: advance one element at a time so a throwing
+            // assignment leaves the remaining elements in the buffer
+            const auto position = head_.load(std::memory_order_relaxed);
+            std::size_t popped = 0;
+            while (popped < max &&
+                   cell(position + popped).sequence.load(std::memory_order_acquire) == position + popped + 1) {
+                consume(position + popped, [&](T&& item) { out[popped] = std::move(item); });
+                ++popped;
+                head_.store(position + popped, std::memory_order_relaxed);
+            }
+            return popped;
+        }
+    }
+
+    /**
+     * @brief Check if the buffer appears empty
+     *
+     * @note The result may be outdated by the time it is used
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Check if the buffer appears full
+     *
+     * @note The result may be outdated by the time it is used
+     */
+    [[nodiscard]] bool full() const noexcept {
+        return size() >= Capacity;
+    }
+
+    /**
+     * @brief Get the approximate number of claimed elements
+     *
+     * Counts claimed positions, so elements that are still being written or
+     * read by a blocked push()/pop() are included.
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        const auto head = head_.load(std::memory_order_acquire);
+        const auto tail = tail_.load(std::memory_order_acquire);
+        const auto used = static_cast<std::intptr_t>(tail - head);
+        return used <= 0 ? 0 : std::min(static_cast<size_type>(used), Capacity);
+    }
+
+    /**
+     * @brief Get the maximum capacity (every slot is usable)
+     */
+    [[nodiscard]] static constexpr size_type capacity() noexcept {
+        return Capacity;
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lock-free multi-producer single-consumer ring buffer
+ *
+ * Offers RingBuffer's try_push/try_emplace/try_pop, push/emplace/pop and
+ * the pointer forms of try_push_n/try_pop_n. The iterator and std::span
+ * batch overloads, try_pop(T&) and the zero-copy APIs are SPSC-only.
+ *
+ * Producers claim slots on a shared tail without locks (compare-exchange in
+ * try_push, a single fetch_add in push); the one consumer pops with plain
+ * loads and stores. Elements from one producer are popped in the order it
+ * pushed them.
+ *
+ * @tparam T The type of elements; must be nothrow move constructible unless
+ *           every construction is noexcept, because a claimed slot can never
+ *           be abandoned (a throwing copy is made before claiming)
+ * @tparam Capacity Number of slots (power of 2); all of them are usable
+ * @tparam Traits Compile-time options; only spinning wait policies apply
+ *
+ * Example usage:
+ * @code
+ * lockfree::MpscRingBuffer<LogRecord, 4096> log_queue;
+ *
+ * // Any gateway thread
+ * log_queue.push(record);
+ *
+ * // Logger thread
+ * while (auto record = log_queue.try_pop()) { write(*record); }
+ * @endcode
+ */
+template <typename T, std::size_t Capacity, typename Traits = RingBufferTraits>
+class MpscRingBuffer : public detail::SequencedRingBuffer<T, Capacity, Traits, true, false> {};
+
+/**
+ * @brief Lock-free single-producer multi-consumer ring buffer
+ *
+ * Offers the same subset of RingBuffer's API as MpscRingBuffer. The one
+ * producer pushes with plain loads and stores; consumers claim elements on
+ * a shared head without locks (compare-exchange in try_pop, a single
+ * fetch_add in pop). Each element is delivered to exactly one consumer.
+ *
+ * @tparam T The type of elements; must be nothrow move constructible
+ * @tparam Capacity Number of slots (power of 2); all of them are usable
+ * @tparam Traits Compile-time options; only spinning wait policies apply
+ */
+template <typename T, std::size_t Capacity, typename Traits = RingBufferTraits>
+class SpmcRingBuffer : public detail::SequencedRingBuffer<T, Capacity, Traits, false, true> {};
+
+} // namespace lockfree
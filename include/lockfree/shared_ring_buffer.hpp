@@ -0,0 +1,396 @@
+/**
+ * @file shared_ring_buffer.hpp
+ * @brief SPSC ring buffer in POSIX shared memory for cross-process messaging
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include "mapped_region.hpp"
+#include "page_allocator.hpp"
+#include "ring_buffer.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace lockfree {
+
+template <typename T, typename Traits>
+class SharedRingBuffer;
+
+namespace detail {
+
+/// Fixed-layout header at offset 0 of every shared ring mapping
+struct SharedRingHeader {
+    static constexpr std::uint64_t kMagic = 0x4C46535043524231ULL;  // "LFSPCRB1"
+    static constexpr std::uint32_t kVersion = 1;
+
+    std::atomic<std::uint64_t> magic;   ///< Stored last by the creator (release)
+    std::uint32_t version;
+    std::uint32_t element_size;
+    std::uint32_t element_align;
+    std::uint32_t traits_flags;
+    std::uint64_t buffer_size;          ///< Number of slots
+    std::uint64_t ring_offset;          ///< Offset of the SharedRing object
+    std::uint64_t mapping_size;         ///< Bytes the creator mapped
+};
+
+/// log2 of a power of 2
+[[nodiscard]] constexpr std::uint32_t log2_exact(std::size_t value) noexcept {
+    std::uint32_t bits = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++bits;
+    }
+    return bits;
+}
+
+template <typename Traits>
+constexpr std::uint32_t shared_traits_flags() noexcept {
+    // The default 64-byte line encodes as 0 so rings created before the
+    // option existed still match
+    const std::uint32_t line = Traits::kCacheLineSize == 64 ? 0U : log2_exact(Traits::kCacheLineSize);
+    return (Traits::kCacheIndices ? 1U : 0U) | (Traits::kFreeRunningIndices ? 2U : 0U) |
+           (Traits::Stats::kEnabled ? 4U : 0U) | (Traits::Layout::kId << 3) | (line << 8);
+}
+
+} // namespace detail
+
+/**
+ * @brief The ring buffer object inside a shared memory mapping
+ *
+ * Has the full RingBuffer API (try_push, try_pop, batch and zero-copy
+ * operations, blocking calls); reach it through a SharedRingBuffer handle.
+ * The indices, each side's cached copy of the other index, and the slots all
+ * live in the mapping, so the hot path is exactly that of RingBuffer.
+ */
+template <typename T, typename Traits = RingBufferTraits>
+class SharedRing : public detail::RingBufferCore<SharedRing<T, Traits>, T, Traits> {
+    using Core = detail::RingBufferCore<SharedRing, T, Traits>;
+    using slot_type = typename Core::slot_type;
+    friend Core;
+    friend class SharedRingBuffer<T, Traits>;
+
+    // Read-only after creation, shared by both processes
+    alignas(Traits::kCacheLineSize) std::size_t index_mask_;
+    std::size_t slots_offset_;  ///< Offset of the slots from this object
+
+    [[nodiscard]] std::size_t index_mask() const noexcept {
+        return index_mask_;
+    }
+
+    [[nodiscard]] slot_type* slot_data() noexcept {
+        return reinterpret_cast<slot_type*>(reinterpret_cast<unsigned char*>(this) + slots_offset_);
+    }
+
+    SharedRing(std::size_t buffer_size, std::size_t slots_offset) noexcept
+        : index_mask_(buffer_size - 1), slots_offset_(slots_offset) {}
+
+    // Elements are trivially destructible and the object is never destroyed
+    // in place: it outlives every process that maps it.
+    ~SharedRing() = default;
+
+public:
+    using typename Core::value_type;
+    using typename Core::size_type;
+
+    /**
+     * @brief Get the maximum capacity
+     *
+     * @return buffer_size() - 1, or buffer_size() with
+     *         RingBufferTraits::kFreeRunningIndices
+     */
+    [[nodiscard]] size_type capacity() const noexcept {
+        return Traits::kFreeRunningIndices ? index_mask_ + 1 : index_mask_;
+    }
+
+    /**
+     * @brief Get the total buffer size (number of slots)
+     */
+    [[nodiscard]] size_type buffer_size() const noexcept {
+        return index_mask_ + 1;
+    }
+};
+
+/**
+ * @brief Handle to an SPSC ring buffer shared between processes
+ *
+ * The header (magic, version, element size, capacity), the head/tail indices
+ * on separate cache lines, and the slot array are all placed in one
+ * shm_open() object or file mapping. One process create()s the ring and the
+ * other attach()es to it by name; both then use the ring through operator->.
+ *
+ * Use create_file()/attach_file() with a path on a hugetlbfs mount (e.g.
+ * /dev/hugepages/feed) to back the ring with huge pages, or pass a
+ * MemoryPlacement to ask for transparent huge pages on the shm object, bind
+ * it to the consumer's NUMA node, and prefault and lock it. Where the pages
+ * live is decided by the creator; an attacher's placement only prefaults and
+ * locks its own mapping.
+ *
+ * The handle that created the ring removes its name on destruction; already
+ * attached processes keep a valid mapping until they close it. After a crash
+ * the name may be left behind; remove() it before creating again.
+ *
+ * @tparam T Element type (trivially copyable, lock-free-compatible layout)
+ * @tparam Traits Compile-time tuning options; both processes must agree
+ *
+ * Example usage:
+ * @code
+ * // Feed handler
+ * auto ring = lockfree::SharedRingBuffer<Tick>::create("/ticks", 65536);
+ * ring->try_push(tick);
+ *
+ * // Strategy engine
+ * auto ring = lockfree::SharedRingBuffer<Tick>::attach("/ticks");
+ * if (auto tick = ring->try_pop()) { ... }
+ * @endcode
+ */
+template <typename T, typename Traits = RingBufferTraits>
+class SharedRingBuffer {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Elements crossing a process boundary must be trivially copyable");
+    static_assert(std::atomic<std::size_t>::is_always_lock_free,
+                  "Process-shared indices require lock-free atomics");
+    static_assert(std::is_empty_v<typename Traits::WaitPolicy::State>,
+                  "Process-shared rings need a spinning wait policy (not SpinSleepWait)");
+
+public:
+    using ring_type = SharedRing<T, Traits>;
+    using size_type = typename ring_type::size_type;
+
+    /**
+     * @brief Create a new shared memory ring buffer
+     *
+     * @param name shm_open() name, e.g. "/feed"
+     * @param buffer_size Number of slots (power of 2, greater than 1)
+     * @param placement How the pages are placed, see MemoryPlacement
+     *
+     * @throws std::invalid_argument if buffer_size is not a power of 2 greater
+     *         than 1 (or below the minimum of Traits::Layout), or
+     *         placement.numa_node is out of range
+     * @throws std::system_error if the name already exists, mapping fails, or
+     *         NUMA binding or mlock() fails
+     */
+    static SharedRingBuffer create(const std::string& name, size_type buffer_size,
+                                   const MemoryPlacement& placement = {}) {
+        detail::FileDescriptor fd(::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600));
+        if (!fd) {
+            detail::throw_errno("shm_open " + name);
+        }
+        return initialize(std::move(fd), name, Backing::kShm, buffer_size, placement);
+    }
+
+    /**
+     * @brief Attach to a ring buffer created by another process
+     *
+     * @param placement Only prefault and lock apply; huge_pages and numa_node
+     *        are ignored, as the creator has already placed the pages
+     *
+     * @throws std::system_error if the name does not exist, mapping fails, or
+     *         mlock() fails
+     * @throws std::runtime_error if the ring is not initialized yet or was
+     *         created with a different element type, version, or traits
+     */
+    static SharedRingBuffer attach(const std::string& name, const MemoryPlacement& placement = {}) {
+        detail::FileDescriptor fd(::shm_open(name.c_str(), O_RDWR, 0));
+        if (!fd) {
+            detail::throw_errno("shm_open " + name);
+        }
+        return open_existing(std::move(fd), name, Backing::kShm, placement);
+    }
+
+    /**
+     * @brief Create a ring buffer backed by a file, e.g. on hugetlbfs
+     *
+     * The mapping size is rounded up to the filesystem block size, which is
+     * the huge page size on hugetlbfs.
+     *
+     * @throws As create()
+     */
+    static SharedRingBuffer create_file(const std::string& path, size_type buffer_size,
+                                        const MemoryPlacement& placement = {}) {
+        detail::FileDescriptor fd(::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600));
+        if (!fd) {
+            detail::throw_errno("open " + path);
+        }
+        return initialize(std::move(fd), path, Backing::kFile, buffer_size, placement);
+    }
+
+    /**
+     * @brief Attach to a file-backed ring buffer created by create_file()
+     *
+     * @throws As attach()
+     */
+    static SharedRingBuffer attach_file(const std::string& path, const MemoryPlacement& placement = {}) {
+        detail::FileDescriptor fd(::open(path.c_str(), O_RDWR));
+        if (!fd) {
+            detail::throw_errno("open " + path);
+        }
+        return open_existing(std::move(fd), path, Backing::kFile, placement);
+    }
+
+    /**
+     * @brief Remove a shm_open() name left behind, e.g. after a crash
+     *
+     * @return true if the name existed and was removed
+     */
+    static bool remove(const std::string& name) noexcept {
+        return ::shm_unlink(name.c_str()) == 0;
+    }
+
+    SharedRingBuffer(SharedRingBuffer&& other) noexcept
+        : region_(std::move(other.region_)),
+          name_(std::move(other.name_)),
+          backing_(other.backing_),
+          owner_(std::exchange(other.owner_, false)) {}
+    SharedRingBuffer& operator=(SharedRingBuffer&& other) noexcept {
+        if (this != &other) {
+            unlink_if_owner();
+            region_ = std::move(other.region_);
+            name_ = std::move(other.name_);
+            backing_ = other.backing_;
+            owner_ = std::exchange(other.owner_, false);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Unmap the ring; the creating handle also removes its name
+     */
+    ~SharedRingBuffer() {
+        unlink_if_owner();
+    }
+
+    [[nodiscard]] ring_type* operator->() const noexcept { return ring_ptr(); }
+    [[nodiscard]] ring_type& operator*() const noexcept { return *ring_ptr(); }
+
+    /// shm_open() name or file path of the ring
+    [[nodiscard]] const std::string& name() const noexcept { return name_; }
+
+    /// Whether this handle created the ring (and removes its name on destruction)
+    [[nodiscard]] bool is_owner() const noexcept { return owner_; }
+
+private:
+    enum class Backing { kShm, kFile };
+
+    using slot_type = typename ring_type::slot_type;
+
+    static constexpr std::size_t kRingOffset =
+        detail::round_up(sizeof(detail::SharedRingHeader), alignof(ring_type));
+    static constexpr std::size_t kSlotsOffset =
+        detail::round_up(sizeof(ring_type), std::max(Traits::kCacheLineSize, alignof(slot_type)));
+
+    detail::MappedRegion region_;
+    std::string name_;
+    Backing backing_;
+    bool owner_;
+
+    SharedRingBuffer(detail::MappedRegion region, std::string name, Backing backing, bool owner) noexcept
+        : region_(std::move(region)), name_(std::move(name)), backing_(backing), owner_(owner) {}
+
+    [[nodiscard]] detail::SharedRingHeader* header() const noexcept {
+        return static_cast<detail::SharedRingHeader*>(region_.data());
+    }
+
+    [[nodiscard]] ring_type* ring_ptr() const noexcept {
+        return reinterpret_cast<ring_type*>(static_cast<unsigned char*>(region_.data()) + kRingOffset);
+    }
+
+    void unlink_if_owner() noexcept {
+        if (owner_) {
+            unlink_name(name_, backing_);
+            owner_ = false;
+        }
+    }
+
+    static void unlink_name(const std::string& name, Backing backing) noexcept {
+        if (backing == Backing::kShm) {
+            ::shm_unlink(name.c_str());
+        } else {
+            ::unlink(name.c_str());
+        }
+    }
+
+    static SharedRingBuffer initialize(detail::FileDescriptor fd, const std::string& name,
+                                       Backing backing, size_type buffer_size,
+                                       const MemoryPlacement& placement) {
+        try {
+            if (buffer_size < 2 || (buffer_size & (buffer_size - 1)) != 0) {
+                throw std::invalid_argument("SharedRingBuffer size must be a power of 2 and greater than 1");
+            }
+            if (buffer_size < ring_type::kMinSlots) {
+                throw std::invalid_argument("SharedRingBuffer size must be at least " +
+                                            std::to_string(ring_type::kMinSlots) + " for its slot layout");
+            }
+            const std::size_t data_offset = kRingOffset + kSlotsOffset;
+            if (buffer_size > (std::numeric_limits<std::size_t>::max() - data_offset) / sizeof(slot_type) / 2) {
+                throw std::length_error("SharedRingBuffer size is too large");
+            }
+            const std::size_t mapping_size =
+                detail::round_up(data_offset + buffer_size * sizeof(slot_type), fd.mapping_granularity());
+            if (::ftruncate(fd.get(), static_cast<off_t>(mapping_size)) != 0) {
+                detail::throw_errno("ftruncate " + name);
+            }
+
+            detail::MappedRegion region(fd, mapping_size);
+            detail::apply_placement(region.data(), mapping_size, placement, true);
+            auto* header = ::new (region.data()) detail::SharedRingHeader{};
+            header->version = detail::SharedRingHeader::kVersion;
+            header->element_size = static_cast<std::uint32_t>(sizeof(T));
+            header->element_align = static_cast<std::uint32_t>(alignof(T));
+            header->traits_flags = detail::shared_traits_flags<Traits>();
+            header->buffer_size = buffer_size;
+            header->ring_offset = kRingOffset;
+            header->mapping_size = mapping_size;
+            ::new (static_cast<unsigned char*>(region.data()) + kRingOffset) ring_type(buffer_size, kSlotsOffset);
+
+            // Publish: an attacher that sees the magic sees the whole layout
+            header->magic.store(detail::SharedRingHeader::kMagic, std::memory_order_release);
+            return SharedRingBuffer(std::move(region), name, backing, true);
+        } catch (...) {
+            unlink_name(name, backing);
+            throw;
+        }
+    }
+
+    static SharedRingBuffer open_existing(detail::FileDescriptor fd, const std::string& name, Backing backing,
+                                          const MemoryPlacement& placement) {
+        const std::size_t file_size = fd.size();
+        if (file_size < kRingOffset + kSlotsOffset) {
+            throw std::runtime_error("SharedRingBuffer " + name + " is not initialized");
+        }
+
+        detail::MappedRegion region(fd, file_size);
+        const auto* header = static_cast<const detail::SharedRingHeader*>(region.data());
+        if (header->magic.load(std::memory_order_acquire) != detail::SharedRingHeader::kMagic) {
+            throw std::runtime_error("SharedRingBuffer " + name + " is not initialized");
+        }
+        if (header->version != detail::SharedRingHeader::kVersion) {
+            throw std::runtime_error("SharedRingBuffer " + name + " has an incompatible layout version");
+        }
+        if (header->element_size != sizeof(T) || header->element_align != alignof(T)) {
+            throw std::runtime_error("SharedRingBuffer " + name + " holds a different element type");
+        }
+        if (header->traits_flags != detail::shared_traits_flags<Traits>()) {
+            throw std::runtime_error("SharedRingBuffer " + name + " was created with different traits");
+        }
+        if (header->ring_offset != kRingOffset ||
+            header->mapping_size > file_size ||
+            header->mapping_size < kRingOffset + kSlotsOffset + header->buffer_size * sizeof(slot_type)) {
+            throw std::runtime_error("SharedRingBuffer " + name + " has an inconsistent header");
+        }
+
+        MemoryPlacement mapping_only;
+        mapping_only.prefault = placement.prefault;
+        mapping_only.lock = placement.lock;
+        detail::apply_placement(region.data(), region.size(), mapping_only, false);
+        return SharedRingBuffer(std::move(region), name, backing, false);
+    }
+};
+
+} // namespace lockfree
@@ -0,0 +1,144 @@
+/**
+ * @file slot_layout.hpp
+ * @brief Slot layout policies mapping ring positions to storage, and the cache line size
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Cache line size used for alignment and padding throughout the library.
+ * Define it to 128 before including any header (or with -D) on Apple M-series
+ * and on Intel parts whose adjacent-line prefetcher pulls lines in pairs.
+ * RingBufferTraits::kCacheLineSize overrides it per ring.
+ */
+#ifndef LOCKFREE_CACHE_LINE_SIZE
+#define LOCKFREE_CACHE_LINE_SIZE 64
+#endif
+
+namespace lockfree {
+namespace detail {
+
+/// Cache line size assumed for alignment and padding
+inline constexpr std::size_t kCacheLineSize = LOCKFREE_CACHE_LINE_SIZE;
+
+static_assert((kCacheLineSize & (kCacheLineSize - 1)) == 0 && kCacheLineSize >= alignof(std::max_align_t),
+              "LOCKFREE_CACHE_LINE_SIZE must be a power of 2 no smaller than alignof(std::max_align_t)");
+
+/// Raw storage for one element; constructed on push, destroyed on pop
+template <typename T>
+struct Slot {
+    alignas(T) unsigned char bytes[sizeof(T)];
+};
+
+/// Smallest b such that 2^b slots of slot_size bytes span a whole line
+[[nodiscard]] constexpr std::size_t scramble_bits(std::size_t slot_size, std::size_t line_size) noexcept {
+    std::size_t bits = 0;
+    while ((std::size_t{1} << bits) * slot_size < line_size) {
+        ++bits;
+    }
+    return bits;
+}
+
+} // namespace detail
+
+/*
+ * A layout policy decides where the element for each ring position lives.
+ * With small elements several consecutive positions share a cache line, so
+ * while the ring is nearly empty the producer writing position i + 1 and the
+ * consumer reading position i contend for the same line, whatever the
+ * alignment of head and tail. Every policy provides:
+ *
+ *   static constexpr std::uint32_t kId;    // recorded by shared rings
+ *
+ *   template <typename T, std::size_t LineSize>
+ *   struct Slots {
+ *       using slot_type;                      // storage for one element
+ *       static constexpr bool kContiguous;    // consecutive positions are adjacent T objects
+ *       static constexpr std::size_t kMinSlots;
+ *       static std::size_t slot_of(std::size_t position, std::size_t mask) noexcept;
+ *   };
+ *
+ * The batch and zero-copy span APIs hand out runs of consecutive positions
+ * as T arrays, so read_span() and try_reserve_n() require kContiguous; the
+ * other operations work with every layout.
+ */
+
+/**
+ * @brief Positions are adjacent elements in one array (default)
+ *
+ * Densest layout, and the only one whose slots can be handed out as runs.
+ */
+struct ContiguousLayout {
+    static constexpr std::uint32_t kId = 0;
+
+    template <typename T, std::size_t LineSize>
+    struct Slots {
+        using slot_type = detail::Slot<T>;
+        static constexpr bool kContiguous = true;
+        static constexpr std::size_t kMinSlots = 2;
+
+        [[nodiscard]] static constexpr std::size_t slot_of(std::size_t position, std::size_t mask) noexcept {
+            return position & mask;
+        }
+    };
+};
+
+/**
+ * @brief Every slot occupies whole cache lines of its own
+ *
+ * Removes slot false sharing at the cost of LineSize bytes per slot; a ring
+ * of 4-byte ints takes 16 times the memory. Elements that already fill whole
+ * lines are stored exactly as with ContiguousLayout.
+ */
+struct PaddedLayout {
+    static constexpr std::uint32_t kId = 1;
+
+    template <typename T, std::size_t LineSize>
+    struct Slots {
+        struct alignas(std::max(LineSize, alignof(T))) slot_type {
+            alignas(T) unsigned char bytes[sizeof(T)];
+        };
+        static constexpr bool kContiguous = sizeof(slot_type) == sizeof(T);
+        static constexpr std::size_t kMinSlots = 2;
+
+        [[nodiscard]] static constexpr std::size_t slot_of(std::size_t position, std::size_t mask) noexcept {
+            return position & mask;
+        }
+    };
+};
+
+/**
+ * @brief Consecutive positions are spread over different cache lines
+ *
+ * Keeps the dense storage but treats the N slots as a (N / 2^b) x 2^b
+ * matrix stored transposed, where 2^b slots fill a line: position
+ * q * 2^b + r goes to slot r * (N / 2^b) + q. Consecutive positions then
+ * land N / 2^b slots apart, at least one line when N >= 2^(2b), e.g. 256
+ * slots for 4-byte elements on 64-byte lines. With a fixed capacity the
+ * mapping is a mask, two shifts and an OR.
+ */
+struct ScrambledLayout {
+    static constexpr std::uint32_t kId = 2;
+
+    template <typename T, std::size_t LineSize>
+    struct Slots {
+        using slot_type = detail::Slot<T>;
+        static constexpr std::size_t kBits = detail::scramble_bits(sizeof(T), LineSize);
+        static constexpr bool kContiguous = kBits == 0;
+        static constexpr std::size_t kMinSlots = std::max<std::size_t>(2, std::size_t{1} << (2 * kBits));
+
+        [[nodiscard]] static constexpr std::size_t slot_of(std::size_t position, std::size_t mask) noexcept {
+            const auto rows = (mask + 1) >> kBits;
+            return ((position & mask) >> kBits) | (position & ((std::size_t{1} << kBits) - 1)) * rows;
+        }
+    };
+};
+
+} // namespace lockfree
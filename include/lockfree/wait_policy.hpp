@@ -0,0 +1,427 @@
+/**
+ * @file wait_policy.hpp
+ * @brief Wait strategies for the blocking ring buffer operations
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(_M_ARM64) || defined(_M_ARM)
+#include <intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <system_error>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+namespace lockfree {
+
+/*
+ * A wait policy tells the blocking operations (push, pop, try_push_for, ...)
+ * how to wait for the other side. Every policy provides:
+ *
+ *   struct State;   // per-direction state embedded in the ring buffer
+ *
+ *   // Called by the blocked side. Returns true once ready() returns true,
+ *   // or false if the deadline expires first.
+ *   template <typename Ready, typename Deadline>
+ *   static bool wait(State&, Ready&& ready, const Deadline& deadline);
+ *
+ *   // Called by the other side every time it publishes progress.
+ *   static void notify(State&) noexcept;
+ *
+ * Policies with an empty State take no space in the ring buffer, and their
+ * notify() compiles to nothing.
+ *
+ * A pollable policy's State also exposes the descriptor it sleeps on, so a
+ * consumer can wait for data in its own event loop (see EventFdWait):
+ *
+ *   int fd() const noexcept;   // readable once notify() signals
+ *   void arm() noexcept;       // ask notify() to signal; then re-check
+ *   void disarm() noexcept;    // withdraw the request
+ *   void clear() noexcept;     // consume signals, making fd() unreadable
+ */
+
+namespace detail {
+
+/// Hint to the CPU that we are in a spin-wait loop
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(_M_ARM64) || defined(_M_ARM)
+    __yield();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/// Deadline that never expires, used by push() and pop()
+struct NoDeadline {
+    static constexpr bool kInfinite = true;
+
+    [[nodiscard]] bool expired() const noexcept { return false; }
+    [[nodiscard]] std::chrono::nanoseconds remaining() const noexcept {
+        return std::chrono::nanoseconds::max();
+    }
+};
+
+/// Deadline on an arbitrary clock, used by the _for/_until variants
+template <typename Clock, typename Duration>
+struct Deadline {
+    static constexpr bool kInfinite = false;
+
+    std::chrono::time_point<Clock, Duration> when;
+
+    [[nodiscard]] bool expired() const { return Clock::now() >= when; }
+    [[nodiscard]] std::chrono::nanoseconds remaining() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(when - Clock::now());
+    }
+};
+
+/// Spin with cpu_relax() until ready, the deadline expires, or spins run out
+template <typename Ready, typename Deadline>
+bool spin(Ready& ready, const Deadline& deadline, int spins, bool& timed_out) {
+    for (int i = 0; i < spins; ++i) {
+        if (ready()) {
+            return true;
+        }
+        if (deadline.expired()) {
+            timed_out = true;
+            return false;
+        }
+        cpu_relax();
+    }
+    return false;
+}
+
+/// Whether Policy's State provides the pollable interface above
+template <typename Policy, typename = void>
+struct is_pollable_wait : std::false_type {};
+
+template <typename Policy>
+struct is_pollable_wait<Policy, std::void_t<decltype(std::declval<const typename Policy::State&>().fd())>>
+    : std::true_type {};
+
+} // namespace detail
+
+/**
+ * @brief Spin on the condition without any CPU hint
+ *
+ * Lowest wake-up latency, but burns a full core and starves a sibling
+ * hyperthread while waiting.
+ */
+struct BusySpinWait {
+    struct State {};
+
+    template <typename Ready, typename Deadline>
+    static bool wait(State&, Ready&& ready, const Deadline& deadline) {
+        while (!ready()) {
+            if (deadline.expired()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void notify(State&) noexcept {}
+};
+
+/**
+ * @brief Spin on the condition with a pause/yield instruction per iteration
+ *
+ * Same latency profile as BusySpinWait, but lets a sibling hyperthread run
+ * and reduces power while waiting.
+ */
+struct PauseSpinWait {
+    struct State {};
+
+    template <typename Ready, typename Deadline>
+    static bool wait(State&, Ready&& ready, const Deadline& deadline) {
+        while (!ready()) {
+            if (deadline.expired()) {
+                return false;
+            }
+            detail::cpu_relax();
+        }
+        return true;
+    }
+
+    static void notify(State&) noexcept {}
+};
+
+/**
+ * @brief Spin briefly, then fall back to std::this_thread::yield()
+ *
+ * The default policy. Matches the classic try_push/yield retry loop, so it
+ * still keeps a core busy when idle, but gives the scheduler a chance to run
+ * other threads.
+ */
+struct SpinYieldWait {
+    struct State {};
+
+    /// Pause iterations before the first yield
+    static constexpr int kSpinCount = 128;
+
+    template <typename Ready, typename Deadline>
+    static bool wait(State&, Ready&& ready, const Deadline& deadline) {
+        bool timed_out = false;
+        if (detail::spin(ready, deadline, kSpinCount, timed_out)) {
+            return true;
+        }
+        while (!timed_out) {
+            if (ready()) {
+                return true;
+            }
+            if (deadline.expired()) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    static void notify(State&) noexcept {}
+};
+
+/**
+ * @brief Spin briefly, then sleep in the kernel until the other side notifies
+ *
+ * An idle waiter costs no CPU. The waiter raises a flag before sleeping, and
+ * the other side only makes a wake-up system call when it sees that flag, so
+ * a ring nobody is sleeping on never pays for a syscall. Every publish does
+ * pay for a full memory fence, which orders the index store against the
+ * flag check. Use this policy for low-rate channels, not the hottest data
+ * paths.
+ *
+ * Uses a futex on Linux and a mutex/condition variable elsewhere.
+ */
+struct SpinSleepWait {
+    struct State {
+        std::atomic<std::uint32_t> waiting{0};  ///< Set while a waiter may be asleep
+        std::atomic<std::uint32_t> epoch{0};    ///< Bumped on every wake-up
+#if !defined(__linux__)
+        std::mutex mutex;
+        std::condition_variable cv;
+#endif
+    };
+
+    /// Pause iterations before going to sleep
+    static constexpr int kSpinCount = 256;
+
+    template <typename Ready, typename Deadline>
+    static bool wait(State& state, Ready&& ready, const Deadline& deadline) {
+        bool timed_out = false;
+        if (detail::spin(ready, deadline, kSpinCount, timed_out)) {
+            return true;
+        }
+        while (!timed_out) {
+            const auto epoch = state.epoch.load(std::memory_order_acquire);
+
+            // Raise the flag before the final check; pairs with the fence in
+            // notify() so either we see the new data or the notifier sees us.
+            state.waiting.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                state.waiting.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            if (deadline.expired()) {
+                break;
+            }
+            sleep_until_notified(state, epoch, deadline);
+        }
+        state.waiting.store(0, std::memory_order_relaxed);
+        return ready();
+    }
+
+    static void notify(State& state) noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (state.waiting.load(std::memory_order_relaxed) != 0) {
+            state.epoch.fetch_add(1, std::memory_order_release);
+            wake_waiter(state);
+        }
+    }
+
+private:
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+                  "futex requires a plain 32-bit word");
+
+    template <typename Deadline>
+    static void sleep_until_notified(State& state, std::uint32_t epoch, const Deadline& deadline) noexcept {
+        timespec timeout{};
+        timespec* timeout_ptr = nullptr;
+        if constexpr (!Deadline::kInfinite) {
+            const auto remaining = deadline.remaining().count();
+            if (remaining <= 0) {
+                return;
+            }
+            timeout.tv_sec = static_cast<std::time_t>(remaining / 1000000000);
+            timeout.tv_nsec = static_cast<long>(remaining % 1000000000);
+            timeout_ptr = &timeout;
+        }
+        // Returns immediately if epoch already moved on
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state.epoch),
+                FUTEX_WAIT_PRIVATE, epoch, timeout_ptr, nullptr, 0);
+    }
+
+    static void wake_waiter(State& state) noexcept {
+        syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&state.epoch),
+                FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+#else
+    template <typename Deadline>
+    static void sleep_until_notified(State& state, std::uint32_t epoch, const Deadline& deadline) {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        const auto moved_on = [&] { return state.epoch.load(std::memory_order_acquire) != epoch; };
+        if constexpr (Deadline::kInfinite) {
+            state.cv.wait(lock, moved_on);
+        } else {
+            state.cv.wait_for(lock, deadline.remaining(), moved_on);
+        }
+    }
+
+    static void wake_waiter(State& state) noexcept {
+        // Taking the lock ensures the waiter is either before its epoch
+        // check or already blocked in the condition variable.
+        { std::lock_guard<std::mutex> lock(state.mutex); }
+        state.cv.notify_one();
+    }
+#endif
+};
+
+#if defined(__linux__)
+/**
+ * @brief Spin briefly, then sleep on an eventfd the other side signals (Linux)
+ *
+ * Works like SpinSleepWait for the blocking calls, but the consumer can also
+ * register the descriptor with epoll or io_uring next to its sockets instead
+ * of polling empty() in a loop; see RingBuffer::notification_fd().
+ *
+ * A waiter arms the state before it sleeps, and notify() disarms it as it
+ * writes the eventfd, so the other side makes one write() per sleep (per
+ * burst after an idle period) rather than one per element. As with
+ * SpinSleepWait, every publish pays for a full fence. Each ring owns two
+ * descriptors, one per direction.
+ */
+struct EventFdWait {
+    class State {
+        int fd_;
+        std::atomic<std::uint32_t> armed_{0};  ///< Set while the waiter wants a signal
+
+    public:
+        /// @throws std::system_error if the eventfd cannot be created
+        State() : fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+            if (fd_ == -1) {
+                throw std::system_error(errno, std::generic_category(), "eventfd");
+            }
+        }
+
+        ~State() {
+            ::close(fd_);
+        }
+
+        State(const State&) = delete;
+        State& operator=(const State&) = delete;
+
+        [[nodiscard]] int fd() const noexcept {
+            return fd_;
+        }
+
+        // Raise the flag before the waiter's final check; pairs with the
+        // fence in signal() so either it sees the new data or we see it.
+        void arm() noexcept {
+            armed_.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void disarm() noexcept {
+            armed_.store(0, std::memory_order_relaxed);
+        }
+
+        void clear() noexcept {
+            std::uint64_t count = 0;
+            (void)::read(fd_, &count, sizeof(count));
+        }
+
+        void signal() noexcept {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (armed_.load(std::memory_order_relaxed) != 0 &&
+                armed_.exchange(0, std::memory_order_relaxed) != 0) {
+                const std::uint64_t one = 1;
+                (void)::write(fd_, &one, sizeof(one));
+            }
+        }
+    };
+
+    /// Pause iterations before going to sleep
+    static constexpr int kSpinCount = 256;
+
+    template <typename Ready, typename Deadline>
+    static bool wait(State& state, Ready&& ready, const Deadline& deadline) {
+        bool timed_out = false;
+        if (detail::spin(ready, deadline, kSpinCount, timed_out)) {
+            return true;
+        }
+        while (!timed_out) {
+            state.arm();
+            if (ready()) {
+                state.disarm();
+                return true;
+            }
+            if (deadline.expired()) {
+                break;
+            }
+            sleep_until_signaled(state, deadline);
+            state.clear();
+        }
+        state.disarm();
+        return ready();
+    }
+
+    static void notify(State& state) noexcept {
+        state.signal();
+    }
+
+private:
+    template <typename Deadline>
+    static void sleep_until_signaled(const State& state, const Deadline& deadline) noexcept {
+        int timeout_ms = -1;
+        if constexpr (!Deadline::kInfinite) {
+            const auto remaining = deadline.remaining().count();
+            if (remaining <= 0) {
+                return;
+            }
+            // Round up so a short timeout does not turn into a busy loop
+            const auto ms = (remaining + 999999) / 1000000;
+            timeout_ms = ms > INT_MAX ? INT_MAX : static_cast<int>(ms);
+        }
+        pollfd pfd{state.fd(), POLLIN, 0};
+        ::poll(&pfd, 1, timeout_ms);
+    }
+};
+#endif
+
+} // namespace lockfree
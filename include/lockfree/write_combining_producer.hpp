@@ -0,0 +1,155 @@
+/**
+ * @file write_combining_producer.hpp
+ * @brief Producer handle that stages pushes and publishes the tail in batches
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * @copyright MIT License (see LICENSE)
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lockfree {
+
+/**
+ * @brief Producer handle that publishes the ring's tail once per batch
+ *
+ * Every try_push() on a ring stores the tail with release semantics, which
+ * takes the consumer's copy of the tail's cache line away from it. A
+ * producer that generates elements one at a time (e.g. from a parser loop)
+ * can push through this handle instead: elements are constructed in their
+ * slots right away, but the tail is only published once batch elements are
+ * staged, when the ring has no room to stage another, when the oldest
+ * staged element has waited max_delay, or on flush(). It trades latency for
+ * throughput; with batch == 1 it behaves like the ring itself.
+ *
+ * Staged elements are invisible to the consumer, so a producer that goes
+ * idle must call flush(). The destructor flushes as well.
+ *
+ * Works with RingBuffer, DynamicRingBuffer and SharedRingBuffer, and any
+ * slot layout. While the handle exists, every push must go through it.
+ *
+ * @tparam Ring Ring buffer type
+ * @tparam Clock Clock for the max_delay threshold
+ *
+ * Example usage:
+ * @code
+ * lockfree::RingBuffer<Packet, 4096> packets;
+ * lockfree::WriteCombiningProducer<decltype(packets)> producer(packets, 32, std::chrono::microseconds(50));
+ *
+ * while (auto packet = parser.next()) {
+ *     while (!producer.try_push(*packet)) { }
+ * }
+ * producer.flush();
+ * @endcode
+ */
+template <typename Ring, typename Clock = std::chrono::steady_clock>
+class WriteCombiningProducer {
+public:
+    using ring_type = Ring;
+    using value_type = typename Ring::value_type;
+    using size_type = typename Ring::size_type;
+    using duration = typename Clock::duration;
+
+private:
+    Ring& ring_;
+    size_type batch_;
+    duration max_delay_;
+    size_type staged_ = 0;                     ///< Constructed but unpublished elements
+    typename Clock::time_point oldest_{};      ///< When the first staged element was staged
+
+    [[nodiscard]] bool is_stale() const {
+        return max_delay_ != duration::zero() && Clock::now() - oldest_ >= max_delay_;
+    }
+
+public:
+    /**
+     * @brief Create a handle pushing into ring
+     *
+     * @param ring Ring to push into; must outlive the handle
+     * @param batch Publish once this many elements are staged
+     * @param max_delay Publish once the oldest staged element is this old,
+     *        checked on each push; zero disables the check
+     *
+     * @throws std::invalid_argument if batch is zero or exceeds ring.capacity()
+     */
+    WriteCombiningProducer(Ring& ring, size_type batch, duration max_delay = duration::zero())
+        : ring_(ring), batch_(batch), max_delay_(max_delay) {
+        if (batch == 0 || batch > ring.capacity()) {
+            throw std::invalid_argument("WriteCombiningProducer batch must be between 1 and the ring capacity");
+        }
+    }
+
+    /// Publishes the staged elements
+    ~WriteCombiningProducer() {
+        flush();
+    }
+
+    WriteCombiningProducer(const WriteCombiningProducer&) = delete;
+    WriteCombiningProducer& operator=(const WriteCombiningProducer&) = delete;
+
+    /**
+     * @brief Construct an element in the next slot, publishing if a threshold is hit
+     *
+     * @return true if the element was staged (or published), false if the
+     *         ring is full; the staged elements are then published so the
+     *         consumer can make room
+     */
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args&&...>) {
+        void* slot = ring_.try_reserve(staged_);
+        if (slot == nullptr) {
+            flush();
+            return false;
+        }
+        ::new (slot) value_type(std::forward<Args>(args)...);
+        if (staged_++ == 0) {
+            if (max_delay_ != duration::zero()) {
+                oldest_ = Clock::now();
+            }
+        } else if (is_stale()) {
+            flush();
+            return true;
+        }
+        if (staged_ == batch_) {
+            flush();
+        }
+        return true;
+    }
+
+    /// Copy version of try_emplace()
+    [[nodiscard]] bool try_push(const value_type& item) noexcept(std::is_nothrow_copy_constructible_v<value_type>) {
+        return try_emplace(item);
+    }
+
+    /// Move version of try_emplace()
+    [[nodiscard]] bool try_push(value_type&& item) noexcept(std::is_nothrow_move_constructible_v<value_type>) {
+        return try_emplace(std::move(item));
+    }
+
+    /// Publish every staged element to the consumer
+    void flush() noexcept {
+        if (staged_ != 0) {
+            ring_.commit(staged_);
+            staged_ = 0;
+        }
+    }
+
+    /// Number of elements staged but not yet visible to the consumer
+    [[nodiscard]] size_type staged() const noexcept {
+        return staged_;
+    }
+
+    /// Elements staged per publish
+    [[nodiscard]] size_type batch() const noexcept {
+        return batch_;
+    }
+};
+
+} // namespace lockfree
@@ -0,0 +1,207 @@
+/**
+ * @file async_ring_buffer_test.cpp
+ * @brief Test suite for the coroutine (co_await) ring buffer adapter
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/async_ring_buffer.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+// Fire-and-forget coroutine: runs eagerly, frees its frame when it finishes
+struct Task {
+    struct promise_type {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+template <typename Ring>
+Task consume(Ring& ring, std::vector<int>& received, int count) {
+    for (int i = 0; i < count; ++i) {
+        received.push_back(co_await ring.async_pop());
+    }
+}
+
+template <typename Ring>
+Task produce(Ring& ring, int first, int count, bool& done) {
+    for (int i = 0; i < count; ++i) {
+        co_await ring.async_push(first + i);
+    }
+    done = true;
+}
+
+// Minimal event loop: one thread resumes posted coroutines and sleeps when idle
+class EventLoop {
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::coroutine_handle<>> queue_;
+    bool stopped_ = false;
+
+public:
+    void post(std::coroutine_handle<> handle) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(handle);
+        }
+        ready_.notify_one();
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopped_ = true;
+        }
+        ready_.notify_one();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            ready_.wait(lock, [this] { return stopped_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            auto handle = queue_.front();
+            queue_.pop_front();
+            lock.unlock();
+            handle.resume();
+            lock.lock();
+        }
+    }
+};
+
+struct LoopExecutor {
+    EventLoop* loop;
+
+    void operator()(std::coroutine_handle<> handle) const noexcept {
+        loop->post(handle);
+    }
+};
+
+} // namespace
+
+TEST_CASE("Async Ring Buffer Inline Resumption", "[async]") {
+    AsyncRingBuffer<int, 4> ring;
+    REQUIRE(ring.capacity() == 3);
+
+    SECTION("Available elements are popped without suspending") {
+        REQUIRE(ring.try_push(7));
+        std::vector<int> received;
+        consume(ring, received, 1);
+        REQUIRE(received == std::vector<int>{7});
+    }
+
+    SECTION("A parked consumer is resumed by the next push") {
+        std::vector<int> received;
+        consume(ring, received, 3);
+        REQUIRE(received.empty());
+
+        REQUIRE(ring.try_push(1));
+        REQUIRE(received == std::vector<int>{1});
+        REQUIRE(ring.try_emplace(2));
+        REQUIRE(ring.try_push(3));
+        REQUIRE(received == std::vector<int>{1, 2, 3});
+        REQUIRE(ring.empty());
+    }
+
+    SECTION("A parked producer is resumed by the next pop") {
+        bool done = false;
+        produce(ring, 0, 5, done);
+        REQUIRE(ring.full());
+        REQUIRE_FALSE(done);
+
+        REQUIRE(ring.try_pop() == 0);
+        REQUIRE(ring.full());
+        REQUIRE_FALSE(done);
+        REQUIRE(ring.try_pop() == 1);
+        REQUIRE(done);
+
+        for (int expected = 2; expected < 5; ++expected) {
+            REQUIRE(ring.try_pop() == expected);
+        }
+        REQUIRE_FALSE(ring.try_pop().has_value());
+    }
+
+    SECTION("Two coroutines hand elements back and forth") {
+        std::vector<int> received;
+        bool done = false;
+        consume(ring, received, 100);
+        produce(ring, 0, 100, done);
+        REQUIRE(done);
+        REQUIRE(received.size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(received[i] == i);
+        }
+    }
+}
+
+TEST_CASE("Async Ring Buffer Event Loop Sessions", "[async][threading]") {
+    constexpr int NUM_SESSIONS = 16;
+    constexpr int ITEMS_PER_SESSION = 2000;
+    using Ring = AsyncRingBuffer<int, 64, RingBufferTraits, LoopExecutor>;
+
+    EventLoop loop;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::vector<std::vector<int>> received(NUM_SESSIONS);
+    for (int s = 0; s < NUM_SESSIONS; ++s) {
+        rings.push_back(std::make_unique<Ring>(LoopExecutor{&loop}));
+    }
+
+    // All sessions share the loop thread and cost nothing while their ring is empty
+    std::atomic<int> finished{0};
+    std::thread loop_thread([&]() {
+        for (int s = 0; s < NUM_SESSIONS; ++s) {
+            [](Ring& ring, std::vector<int>& out, int count, std::atomic<int>& finished) -> Task {
+                for (int i = 0; i < count; ++i) {
+                    out.push_back(co_await ring.async_pop());
+                }
+                ++finished;
+            }(*rings[s], received[s], ITEMS_PER_SESSION, finished);
+        }
+        loop.run();
+    });
+
+    std::thread producer([&]() {
+        for (int i = 0; i < ITEMS_PER_SESSION; ++i) {
+            for (int s = 0; s < NUM_SESSIONS; ++s) {
+                while (!rings[s]->try_push(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    });
+
+    producer.join();
+    while (finished.load() != NUM_SESSIONS) {
+        std::this_thread::yield();
+    }
+    loop.stop();
+    loop_thread.join();
+
+    for (int s = 0; s < NUM_SESSIONS; ++s) {
+        REQUIRE(received[s].size() == static_cast<std::size_t>(ITEMS_PER_SESSION));
+        bool ordered = true;
+        for (int i = 0; i < ITEMS_PER_SESSION; ++i) {
+            ordered = ordered && received[s][i] == i;
+        }
+        REQUIRE(ordered);
+    }
+}
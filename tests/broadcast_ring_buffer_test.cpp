@@ -0,0 +1,251 @@
+/**
+ * @file broadcast_ring_buffer_test.cpp
+ * @brief Test suite for the single-producer multi-reader broadcast ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/broadcast_ring_buffer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+// Two words that must always be seen together
+struct Pair {
+    std::uint64_t value;
+    std::uint64_t check;
+};
+
+} // namespace
+
+TEST_CASE("Broadcast Ring Buffer Gated Mode", "[broadcast]") {
+    BroadcastRingBuffer<int, 8, 3> ring;
+    auto fast = ring.reader(0);
+    auto slow = ring.reader(1);
+    auto idle = ring.reader(2);
+
+    SECTION("Every reader sees every element") {
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(ring.try_push(i));
+        }
+        for (auto reader : {fast, slow, idle}) {
+            for (int i = 0; i < 5; ++i) {
+                auto item = reader.try_pop();
+                REQUIRE(item.has_value());
+                REQUIRE(*item == i);
+            }
+            REQUIRE_FALSE(reader.try_pop().has_value());
+            REQUIRE(reader.empty());
+        }
+        REQUIRE(ring.published() == 5);
+    }
+
+    SECTION("The slowest reader gates the producer") {
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(ring.try_push(i));
+        }
+        REQUIRE_FALSE(ring.try_push(8));
+
+        // Two readers catching up is not enough
+        while (fast.try_pop()) {}
+        while (slow.try_pop()) {}
+        REQUIRE_FALSE(ring.try_push(8));
+        REQUIRE(idle.size() == 8);
+
+        REQUIRE(idle.try_pop() == 0);
+        REQUIRE(ring.try_push(8));
+        REQUIRE_FALSE(ring.try_push(9));
+        REQUIRE(fast.try_pop() == 8);
+        REQUIRE(idle.dropped() == 0);
+    }
+
+    SECTION("Readers can consume in place") {
+        for (int i = 0; i < 6; ++i) {
+            REQUIRE(ring.try_push(i));
+        }
+        REQUIRE(fast.front() != nullptr);
+        REQUIRE(*fast.front() == 0);
+        fast.pop_front();
+
+        auto region = fast.read_span();
+        REQUIRE(region.size() == 5);
+        REQUIRE(region.first[0] == 1);
+        fast.release(region.size());
+        REQUIRE(fast.front() == nullptr);
+
+        // Wrap around so the readable range splits in two
+        while (slow.try_pop()) {}
+        while (idle.try_pop()) {}
+        for (int i = 6; i < 12; ++i) {
+            REQUIRE(ring.try_push(i));
+        }
+        region = fast.read_span();
+        REQUIRE(region.first.size == 2);
+        REQUIRE(region.second.size == 4);
+        REQUIRE(region.first[0] == 6);
+        REQUIRE(region.second[3] == 11);
+    }
+
+    SECTION("Out-of-range reader index throws") {
+        REQUIRE_THROWS_AS(ring.reader(3), std::out_of_range);
+    }
+}
+
+TEST_CASE("Broadcast Ring Buffer Element Lifetime", "[broadcast]") {
+    BroadcastRingBuffer<std::string, 4, 2> ring;
+    auto first = ring.reader(0);
+    auto second = ring.reader(1);
+    const std::string long_string(64, 'x');
+
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            ring.push(long_string + std::to_string(lap * 4 + i));
+        }
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(first.pop() == long_string + std::to_string(lap * 4 + i));
+            REQUIRE(second.pop() == long_string + std::to_string(lap * 4 + i));
+        }
+    }
+    // Elements from the last lap are destroyed with the ring (ASan checks for leaks)
+    ring.emplace(3, 'y');
+}
+
+TEST_CASE("Broadcast Ring Buffer Lossy Mode", "[broadcast]") {
+    BroadcastRingBuffer<Pair, 8, 2, BroadcastMode::kLossy> ring;
+    auto current = ring.reader(0);
+    auto lagging = ring.reader(1);
+
+    SECTION("The producer never fails") {
+        for (std::uint64_t i = 0; i < 100; ++i) {
+            REQUIRE(ring.try_push(Pair{i, ~i}));
+            if (i % 4 == 3) {
+                while (current.try_pop()) {}
+            }
+        }
+        REQUIRE(current.dropped() == 0);
+    }
+
+    SECTION("A lapped reader skips ahead and counts what it missed") {
+        for (std::uint64_t i = 0; i < 20; ++i) {
+            ring.push(Pair{i, ~i});
+        }
+        REQUIRE(lagging.size() == 8);
+
+        auto item = lagging.try_pop();
+        REQUIRE(item.has_value());
+        // The slot about to be overwritten next is skipped as well
+        REQUIRE(item->value == 13);
+        REQUIRE(lagging.dropped() == 13);
+
+        std::uint64_t expected = 14;
+        while (auto next = lagging.try_pop()) {
+            REQUIRE(next->value == expected++);
+        }
+        REQUIRE(expected == 20);
+        REQUIRE(lagging.dropped() == 13);
+    }
+}
+
+TEST_CASE("Broadcast Ring Buffer Concurrent Gated Readers", "[broadcast][threading]") {
+    constexpr std::size_t NUM_READERS = 3;
+    constexpr std::uint64_t NUM_ITEMS = 200000;
+    auto ring = std::make_unique<BroadcastRingBuffer<std::uint64_t, 256, NUM_READERS>>();
+
+    std::atomic<std::size_t> ordered_readers{0};
+    std::vector<std::thread> readers;
+    for (std::size_t r = 0; r < NUM_READERS; ++r) {
+        readers.emplace_back([&, r]() {
+            auto reader = ring->reader(r);
+            bool ordered = true;
+            std::uint64_t expected = 0;
+            while (expected < NUM_ITEMS) {
+                if (r == 0) {
+                    ordered = ordered && reader.pop() == expected++;
+                    continue;
+                }
+                // Batched in-place reads on the other readers
+                const auto region = reader.read_span();
+                if (region.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (auto value : region.first) {
+                    ordered = ordered && value == expected++;
+                }
+                for (auto value : region.second) {
+                    ordered = ordered && value == expected++;
+                }
+                reader.release(region.size());
+            }
+            if (ordered) {
+                ++ordered_readers;
+            }
+        });
+    }
+
+    for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+        if (i % 2 == 0) {
+            ring->push(i);
+        } else {
+            while (!ring->try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    REQUIRE(ordered_readers == NUM_READERS);
+}
+
+TEST_CASE("Broadcast Ring Buffer Concurrent Lossy Reader", "[broadcast][threading]") {
+    constexpr std::uint64_t NUM_ITEMS = 500000;
+    auto ring = std::make_unique<BroadcastRingBuffer<Pair, 64, 1, BroadcastMode::kLossy>>();
+
+    std::atomic<bool> done{false};
+    std::uint64_t received = 0;
+    bool consistent = true;
+    bool increasing = true;
+    std::uint64_t dropped = 0;
+    std::thread reader_thread([&]() {
+        auto reader = ring->reader(0);
+        std::uint64_t last = 0;
+        bool first = true;
+        while (true) {
+            const bool finished = done.load(std::memory_order_acquire);
+            auto item = reader.try_pop();
+            if (!item) {
+                if (finished) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            consistent = consistent && item->check == ~item->value;
+            increasing = increasing && (first || item->value > last);
+            first = false;
+            last = item->value;
+            ++received;
+        }
+        dropped = reader.dropped();
+    });
+
+    for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+        ring->push(Pair{i, ~i});
+    }
+    done.store(true, std::memory_order_release);
+    reader_thread.join();
+
+    REQUIRE(consistent);
+    REQUIRE(increasing);
+    REQUIRE(received + dropped == NUM_ITEMS);
+}
@@ -0,0 +1,242 @@
+/**
+ * @file byte_ring_buffer_test.cpp
+ * @brief Test suite for the variable-length message ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/byte_ring_buffer.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+// Deterministic message sizes in the 40..1500 byte order-entry range
+std::size_t message_size(std::uint64_t sequence) {
+    return 40 + static_cast<std::size_t>((sequence * 2654435761u) % 1461);
+}
+
+// Fill a message with its sequence number followed by a recognisable pattern
+void fill_message(unsigned char* data, std::size_t size, std::uint64_t sequence) {
+    std::memcpy(data, &sequence, sizeof(sequence));
+    for (std::size_t i = sizeof(sequence); i < size; ++i) {
+        data[i] = static_cast<unsigned char>(sequence + i);
+    }
+}
+
+bool check_message(const ByteRingBuffer<8192>::message_type& message, std::uint64_t sequence) {
+    if (!message.data || message.size != message_size(sequence)) {
+        return false;
+    }
+    std::uint64_t stored;
+    std::memcpy(&stored, message.data, sizeof(stored));
+    if (stored != sequence) {
+        return false;
+    }
+    for (std::size_t i = sizeof(sequence); i < message.size; ++i) {
+        if (message.data[i] != static_cast<unsigned char>(sequence + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Byte Ring Buffer Basic Operations", "[bytes]") {
+    ByteRingBuffer<256> ring;
+
+    SECTION("Initial state") {
+        REQUIRE(ring.empty());
+        REQUIRE(ring.size_bytes() == 0);
+        REQUIRE(ring.capacity() == 256);
+        REQUIRE(ring.max_message_size() == 120);
+        REQUIRE(ring.read().data == nullptr);
+    }
+
+    SECTION("Messages of different sizes round trip in order") {
+        const std::string first = "hello";
+        const std::string second(100, 'x');
+        REQUIRE(ring.try_push(first.data(), first.size()));
+        REQUIRE(ring.try_push(second.data(), second.size()));
+        REQUIRE(ring.size_bytes() == 16 + 112);
+
+        auto message = ring.read();
+        REQUIRE(message.data != nullptr);
+        REQUIRE(std::string(reinterpret_cast<const char*>(message.data), message.size) == first);
+        ring.release();
+
+        message = ring.read();
+        REQUIRE(std::string(reinterpret_cast<const char*>(message.data), message.size) == second);
+        ring.release();
+
+        REQUIRE(ring.empty());
+        REQUIRE(ring.read().data == nullptr);
+    }
+
+    SECTION("Zero-length messages are delivered") {
+        REQUIRE(ring.try_push(nullptr, 0));
+        auto message = ring.read();
+        REQUIRE(message.data != nullptr);
+        REQUIRE(message.size == 0);
+        ring.release();
+        REQUIRE(ring.empty());
+    }
+
+    SECTION("read() without release() returns the same message") {
+        REQUIRE(ring.try_push("abc", 3));
+        auto first = ring.read();
+        auto again = ring.read();
+        REQUIRE(first.data == again.data);
+        REQUIRE(first.size == again.size);
+    }
+
+    SECTION("Payloads are 8-byte aligned") {
+        for (std::size_t size : {1u, 3u, 9u, 17u}) {
+            void* space = ring.try_reserve(size);
+            REQUIRE(space != nullptr);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(space) % ByteRingBuffer<256>::kRecordAlignment == 0);
+            ring.commit(size);
+        }
+    }
+
+    SECTION("Oversized and non-fitting messages are rejected") {
+        REQUIRE(ring.try_reserve(ring.max_message_size() + 1) == nullptr);
+        REQUIRE(ring.try_reserve(ring.max_message_size()) != nullptr);
+        ring.commit(ring.max_message_size());
+        REQUIRE(ring.try_reserve(ring.max_message_size()) != nullptr);
+        ring.commit(ring.max_message_size());
+        REQUIRE(ring.size_bytes() == 256);
+        REQUIRE_FALSE(ring.try_push("x", 1));
+    }
+}
+
+TEST_CASE("Byte Ring Buffer Reserve and Commit", "[bytes]") {
+    ByteRingBuffer<256> ring;
+
+    SECTION("Commit fewer bytes than reserved") {
+        auto* space = static_cast<unsigned char*>(ring.try_reserve(100));
+        REQUIRE(space != nullptr);
+        std::memcpy(space, "short", 5);
+        ring.commit(5);
+        REQUIRE(ring.size_bytes() == 16);
+
+        auto message = ring.read();
+        REQUIRE(message.size == 5);
+        REQUIRE(std::memcmp(message.data, "short", 5) == 0);
+    }
+
+    SECTION("Construct a message in place") {
+        struct Order {
+            std::uint64_t id;
+            double price;
+        };
+        void* space = ring.try_reserve(sizeof(Order));
+        REQUIRE(space != nullptr);
+        new (space) Order{42, 99.5};
+        ring.commit(sizeof(Order));
+
+        auto message = ring.read();
+        REQUIRE(message.size == sizeof(Order));
+        Order order;
+        std::memcpy(&order, message.data, sizeof(order));
+        REQUIRE(order.id == 42);
+        REQUIRE(order.price == 99.5);
+    }
+
+    SECTION("Records never wrap; padding skips to the start") {
+        // 3 x 72-byte records leave 40 bytes before the wrap point
+        std::vector<unsigned char> payload(64, 0xAB);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(ring.try_push(payload.data(), payload.size()));
+        }
+        for (int i = 0; i < 2; ++i) {
+            REQUIRE(ring.read().size == 64);
+            ring.release();
+        }
+
+        // 48-byte record does not fit in the last 40 bytes
+        std::vector<unsigned char> wrapped(40, 0xCD);
+        auto* space = static_cast<unsigned char*>(ring.try_reserve(wrapped.size()));
+        REQUIRE(space != nullptr);
+        std::memcpy(space, wrapped.data(), wrapped.size());
+        ring.commit(wrapped.size());
+
+        REQUIRE(ring.read().size == 64);
+        ring.release();
+        auto message = ring.read();
+        REQUIRE(message.size == 40);
+        REQUIRE(std::memcmp(message.data, wrapped.data(), wrapped.size()) == 0);
+        ring.release();
+        REQUIRE(ring.empty());
+    }
+}
+
+TEST_CASE("Byte Ring Buffer Wrap-Around Stress", "[bytes]") {
+    ByteRingBuffer<8192> ring;
+    std::vector<unsigned char> scratch(ByteRingBuffer<8192>::max_message_size());
+
+    std::uint64_t written = 0;
+    std::uint64_t read = 0;
+    while (read < 20000) {
+        // Write until full, then drain about half
+        while (true) {
+            const auto size = message_size(written);
+            fill_message(scratch.data(), size, written);
+            if (!ring.try_push(scratch.data(), size)) {
+                break;
+            }
+            ++written;
+        }
+        const auto target = read + (written - read + 1) / 2;
+        while (read < target) {
+            REQUIRE(check_message(ring.read(), read));
+            ring.release();
+            ++read;
+        }
+    }
+}
+
+TEST_CASE("Byte Ring Buffer SPSC Correctness", "[bytes][threading]") {
+    ByteRingBuffer<8192> ring;
+    constexpr std::uint64_t NUM_MESSAGES = 200000;
+    bool all_valid = true;
+
+    std::thread producer([&]() {
+        for (std::uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+            const auto size = message_size(i);
+            void* space;
+            while (!(space = ring.try_reserve(size))) {
+                std::this_thread::yield();
+            }
+            fill_message(static_cast<unsigned char*>(space), size, i);
+            ring.commit(size);
+        }
+    });
+
+    std::thread consumer([&]() {
+        for (std::uint64_t i = 0; i < NUM_MESSAGES; ++i) {
+            ByteRingBuffer<8192>::message_type message;
+            while (!(message = ring.read()).data) {
+                std::this_thread::yield();
+            }
+            if (!check_message(message, i)) {
+                all_valid = false;
+            }
+            ring.release();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    REQUIRE(all_valid);
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,60 @@
+# Checks the assembly of tests/codegen_probe.cpp (GCC/Clang, x86-64, AT&T syntax).
+#
+# Usage: cmake -DASM=<codegen_probe.s> -P check_codegen.cmake
+#
+# Each probe is one try_push or try_pop, slow path included. It must stay
+# within its instruction budget and must not call out, spill to the stack,
+# or use a locked instruction or fence: on x86-64 the acquire and release
+# index accesses are plain loads and stores.
+
+set(budgets
+    probe_try_push_u64=28
+    probe_try_pop_u64=24
+    probe_try_push_pair=28
+    probe_try_pop_pair=24
+)
+
+file(STRINGS "${ASM}" lines)
+
+set(current "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^_?(probe_[a-z0-9_]+):")
+        set(current ${CMAKE_MATCH_1})
+        set(count_${current} 0)
+        set(bad_${current} "")
+    elseif(current AND line MATCHES "^[ \t]*\\.size[ \t]")
+        set(current "")
+    elseif(current AND line MATCHES "^[ \t]+([a-z][a-z0-9]*)")
+        math(EXPR count_${current} "${count_${current}} + 1")
+        set(mnemonic ${CMAKE_MATCH_1})
+        if(mnemonic MATCHES "^(call|lock|xchg|mfence|sfence|lfence)" OR line MATCHES "\\(%rsp\\)|@PLT")
+            string(STRIP "${line}" instruction)
+            list(APPEND bad_${current} "${instruction}")
+        endif()
+    endif()
+endforeach()
+
+set(failed FALSE)
+foreach(entry IN LISTS budgets)
+    string(REPLACE "=" ";" entry "${entry}")
+    list(GET entry 0 probe)
+    list(GET entry 1 budget)
+    if(NOT DEFINED count_${probe})
+        message(SEND_ERROR "${probe}: not found in ${ASM}")
+        set(failed TRUE)
+        continue()
+    endif()
+    message(STATUS "${probe}: ${count_${probe}} instructions (budget ${budget})")
+    if(count_${probe} GREATER budget)
+        message(SEND_ERROR "${probe}: ${count_${probe}} instructions exceed the budget of ${budget}")
+        set(failed TRUE)
+    endif()
+    if(bad_${probe})
+        message(SEND_ERROR "${probe}: unexpected instructions: ${bad_${probe}}")
+        set(failed TRUE)
+    endif()
+endforeach()
+
+if(failed)
+    message(FATAL_ERROR "Hot-path codegen check failed for ${ASM}")
+endif()
@@ -0,0 +1,44 @@
+/**
+ * @file codegen_probe.cpp
+ * @brief Hot-path instantiations compiled to assembly by the codegen check
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ *
+ * Not linked into a test: tests/CMakeLists.txt compiles this file with -S and
+ * check_codegen.cmake holds each probe_* function to an instruction budget.
+ */
+
+#include <lockfree/ring_buffer.hpp>
+
+#include <cstdint>
+
+namespace {
+
+struct Pair {
+    std::uint32_t key;
+    std::uint32_t value;
+};
+
+using WordRing = lockfree::RingBuffer<std::uint64_t, 1024>;
+using PairRing = lockfree::RingBuffer<Pair, 1024>;
+
+} // namespace
+
+extern "C" {
+
+bool probe_try_push_u64(WordRing& ring, std::uint64_t value) {
+    return ring.try_push(value);
+}
+
+bool probe_try_pop_u64(WordRing& ring, std::uint64_t& out) {
+    return ring.try_pop(out);
+}
+
+bool probe_try_push_pair(PairRing& ring, Pair value) {
+    return ring.try_push(value);
+}
+
+bool probe_try_pop_pair(PairRing& ring, Pair& out) {
+    return ring.try_pop(out);
+}
+
+} // extern "C"
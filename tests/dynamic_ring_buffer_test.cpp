@@ -0,0 +1,184 @@
+/**
+ * @file dynamic_ring_buffer_test.cpp
+ * @brief Test suite for the runtime-capacity SPSC ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/dynamic_ring_buffer.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+// Allocator that records how much storage it handed out
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    std::size_t* bytes_allocated;
+
+    explicit CountingAllocator(std::size_t* counter) : bytes_allocated(counter) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : bytes_allocated(other.bytes_allocated) {}
+
+    T* allocate(std::size_t n) {
+        *bytes_allocated += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        *bytes_allocated -= n * sizeof(T);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>& other) const { return bytes_allocated == other.bytes_allocated; }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>& other) const { return !(*this == other); }
+};
+
+struct FreeRunningTraits : RingBufferTraits {
+    static constexpr bool kFreeRunningIndices = true;
+};
+
+struct DynamicPaddedTraits : RingBufferTraits {
+    using Layout = PaddedLayout;
+};
+
+struct DynamicScrambledTraits : RingBufferTraits {
+    using Layout = ScrambledLayout;
+};
+
+} // namespace
+
+TEST_CASE("Dynamic Ring Buffer Basic Operations", "[dynamic][basic]") {
+    DynamicRingBuffer<int> buffer(8);
+
+    SECTION("Initial state") {
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.capacity() == 7);
+        REQUIRE(buffer.buffer_size() == 8);
+    }
+
+    SECTION("Fill to capacity and drain") {
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        REQUIRE(buffer.full());
+        REQUIRE_FALSE(buffer.try_push(999));
+
+        for (int i = 0; i < 7; ++i) {
+            auto item = buffer.try_pop();
+            REQUIRE(item.has_value());
+            REQUIRE(*item == i);
+        }
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("Batch and zero-copy APIs across the wrap point") {
+        int scratch[5] = {};
+        REQUIRE(buffer.try_push_n(scratch, 5) == 5);
+        REQUIRE(buffer.try_pop_n(scratch, 5) == 5);
+
+        const int input[] = {10, 11, 12, 13, 14, 15};
+        REQUIRE(buffer.try_push_n(input, 6) == 6);
+
+        auto readable = buffer.read_span();
+        REQUIRE(readable.first.size == 3);
+        REQUIRE(readable.second.size == 3);
+        REQUIRE(readable.second[0] == 13);
+        buffer.release(readable.size());
+        REQUIRE(buffer.empty());
+    }
+}
+
+TEST_CASE("Dynamic Ring Buffer Construction", "[dynamic][basic]") {
+    SECTION("Rejects capacities that are not a power of 2") {
+        REQUIRE_THROWS_AS(DynamicRingBuffer<int>(0), std::invalid_argument);
+        REQUIRE_THROWS_AS(DynamicRingBuffer<int>(1), std::invalid_argument);
+        REQUIRE_THROWS_AS(DynamicRingBuffer<int>(1000), std::invalid_argument);
+    }
+
+    SECTION("Slot layouts size the storage and enforce their minimum") {
+        std::size_t bytes = 0;
+        {
+            DynamicRingBuffer<int, CountingAllocator<int>, DynamicPaddedTraits> padded(
+                8, CountingAllocator<int>(&bytes));
+            REQUIRE(bytes == 8 * 64);
+            REQUIRE(padded.try_push(1));
+            REQUIRE(padded.try_pop() == 1);
+        }
+
+        using Scrambled = DynamicRingBuffer<int, std::allocator<int>, DynamicScrambledTraits>;
+        REQUIRE_THROWS_AS(Scrambled(128), std::invalid_argument);
+        Scrambled scrambled(256);
+        for (int i = 0; i < 600; ++i) {
+            REQUIRE(scrambled.try_push(i));
+            REQUIRE(scrambled.try_pop() == i);
+        }
+    }
+
+    SECTION("Full-capacity traits") {
+        DynamicRingBuffer<int, std::allocator<int>, FreeRunningTraits> buffer(4);
+        REQUIRE(buffer.capacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        REQUIRE(buffer.full());
+    }
+
+    SECTION("Storage comes from the allocator and is cache-line aligned") {
+        std::size_t bytes = 0;
+        {
+            DynamicRingBuffer<std::string, CountingAllocator<std::string>> buffer(
+                1024, CountingAllocator<std::string>(&bytes));
+            REQUIRE(bytes >= 1024 * sizeof(std::string));
+            REQUIRE(bytes % 64 == 0);
+
+            REQUIRE(buffer.try_emplace("queued"));
+            const auto address = reinterpret_cast<std::uintptr_t>(buffer.front());
+            REQUIRE(address % 64 == 0);
+        }
+        REQUIRE(bytes == 0);
+    }
+}
+
+TEST_CASE("Dynamic Ring Buffer SPSC Correctness", "[dynamic][spsc][threading]") {
+    DynamicRingBuffer<int> buffer(256);
+    constexpr int NUM_ITEMS = 50000;
+
+    std::vector<int> received_items;
+    received_items.reserve(NUM_ITEMS);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!buffer.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([&]() {
+        while (received_items.size() < NUM_ITEMS) {
+            if (auto item = buffer.try_pop()) {
+                received_items.push_back(*item);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        REQUIRE(received_items[i] == i);
+    }
+}
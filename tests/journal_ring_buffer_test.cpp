@@ -0,0 +1,259 @@
+/**
+ * @file journal_ring_buffer_test.cpp
+ * @brief Test suite for the memory-mapped journaling ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/journal_ring_buffer.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace lockfree;
+
+namespace {
+
+struct Order {
+    std::uint64_t sequence;
+    double price;
+    std::uint32_t quantity;
+};
+
+// Unique per test process so parallel ctest runs do not collide
+std::string unique_directory(const char* suffix) {
+    return "/tmp/lockfree_journal_" + std::to_string(::getpid()) + "_" + suffix;
+}
+
+bool file_exists(const std::string& path) {
+    struct stat info {};
+    return ::stat(path.c_str(), &info) == 0;
+}
+
+JournalOptions small_segments(std::size_t commit_every = 0) {
+    JournalOptions options;
+    options.segment_entries = 8;
+    options.capacity = 20;
+    options.commit_every = commit_every;
+    return options;
+}
+
+} // namespace
+
+TEST_CASE("Journal Ring Buffer Basic Operations", "[journal]") {
+    const auto directory = unique_directory("basic");
+    JournalRingBuffer<Order>::remove(directory);
+
+    SECTION("Entries cross segments and stay on disk") {
+        auto journal = JournalRingBuffer<Order>::open(directory, small_segments());
+        REQUIRE(journal.empty());
+        REQUIRE(journal.capacity() == 20);
+        REQUIRE(journal.segment_entries() == 8);
+
+        for (std::uint64_t i = 0; i < 20; ++i) {
+            REQUIRE(journal.try_push(Order{i, 1.5 * i, 1}));
+        }
+        REQUIRE_FALSE(journal.try_push(Order{}));
+        REQUIRE(journal.size() == 20);
+        REQUIRE(file_exists(journal.segment_path(2)));
+
+        for (std::uint64_t i = 0; i < 20; ++i) {
+            auto order = journal.try_pop();
+            REQUIRE(order.has_value());
+            REQUIRE(order->sequence == i);
+            REQUIRE(order->price == 1.5 * i);
+        }
+        REQUIRE_FALSE(journal.try_pop().has_value());
+        REQUIRE(journal.head() == 20);
+        REQUIRE(journal.tail() == 20);
+
+        // Finishing a segment commits it
+        REQUIRE(journal.committed_head() == 16);
+        journal.commit();
+        REQUIRE(journal.committed_head() == 20);
+        REQUIRE(file_exists(journal.segment_path(0)));
+    }
+
+    SECTION("commit_every commits in batches") {
+        auto journal = JournalRingBuffer<Order>::open(directory, small_segments(3));
+        for (std::uint64_t i = 0; i < 7; ++i) {
+            REQUIRE(journal.try_push(Order{i, 0.0, 0}));
+        }
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(journal.try_pop().has_value());
+        }
+        REQUIRE(journal.committed_head() == 3);
+        REQUIRE(journal.try_pop().has_value());
+        REQUIRE(journal.committed_head() == 6);
+    }
+
+    SECTION("Invalid options and mismatched journals are rejected") {
+        JournalOptions odd_segments;
+        odd_segments.segment_entries = 12;
+        REQUIRE_THROWS_AS(JournalRingBuffer<Order>::open(directory, odd_segments), std::invalid_argument);
+
+        JournalOptions no_room;
+        no_room.capacity = 0;
+        REQUIRE_THROWS_AS(JournalRingBuffer<Order>::open(directory, no_room), std::invalid_argument);
+
+        { auto journal = JournalRingBuffer<Order>::open(directory, small_segments()); }
+        REQUIRE_THROWS_AS(JournalRingBuffer<std::uint32_t>::open(directory), std::runtime_error);
+    }
+
+    REQUIRE(JournalRingBuffer<Order>::remove(directory));
+}
+
+TEST_CASE("Journal Ring Buffer Recovery", "[journal]") {
+    const auto directory = unique_directory("recovery");
+    JournalRingBuffer<Order>::remove(directory);
+
+    SECTION("A reopened journal resumes from the committed head") {
+        {
+            auto journal = JournalRingBuffer<Order>::open(directory, small_segments());
+            for (std::uint64_t i = 0; i < 12; ++i) {
+                REQUIRE(journal.try_push(Order{i, 0.0, 0}));
+            }
+            for (int i = 0; i < 5; ++i) {
+                REQUIRE(journal.try_pop().has_value());
+            }
+            journal.commit();
+            REQUIRE(journal.try_pop().has_value());  // Popped but never committed
+        }
+
+        JournalOptions other_segments = small_segments();
+        other_segments.segment_entries = 64;
+        auto journal = JournalRingBuffer<Order>::open(directory, other_segments);
+        REQUIRE(journal.segment_entries() == 8);  // Fixed at creation
+        REQUIRE(journal.head() == 5);
+        REQUIRE(journal.size() == 7);
+        for (std::uint64_t i = 5; i < 12; ++i) {
+            REQUIRE(journal.try_pop()->sequence == i);
+        }
+        REQUIRE(journal.try_push(Order{12, 0.0, 0}));
+        REQUIRE(journal.try_pop()->sequence == 12);
+    }
+
+    SECTION("Entries published before a crash survive it") {
+        const pid_t child = ::fork();
+        REQUIRE(child >= 0);
+        if (child == 0) {
+            // Exit without unwinding, as a crash would
+            int status = 0;
+            try {
+                auto journal = JournalRingBuffer<Order>::open(directory, small_segments(4));
+                for (std::uint64_t i = 0; i < 18; ++i) {
+                    status |= journal.try_push(Order{i, 2.0 * i, 7}) ? 0 : 1;
+                }
+                for (int i = 0; i < 10; ++i) {
+                    status |= journal.try_pop().has_value() ? 0 : 1;
+                }
+            } catch (...) {
+                status = 1;
+            }
+            ::_exit(status);
+        }
+        int status = 0;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+
+        auto journal = JournalRingBuffer<Order>::open(directory, small_segments(4));
+        REQUIRE(journal.committed_head() == 8);
+        REQUIRE(journal.size() == 10);
+        for (std::uint64_t i = 8; i < 18; ++i) {
+            auto order = journal.try_pop();
+            REQUIRE(order.has_value());
+            REQUIRE(order->sequence == i);
+            REQUIRE(order->price == 2.0 * i);
+            REQUIRE(order->quantity == 7);
+        }
+    }
+
+    SECTION("A removed segment that is still needed is reported") {
+        {
+            auto journal = JournalRingBuffer<Order>::open(directory, small_segments());
+            for (std::uint64_t i = 0; i < 4; ++i) {
+                REQUIRE(journal.try_push(Order{i, 0.0, 0}));
+            }
+            ::unlink(journal.segment_path(0).c_str());
+        }
+        REQUIRE_THROWS_AS(JournalRingBuffer<Order>::open(directory, small_segments()), std::runtime_error);
+    }
+
+    REQUIRE(JournalRingBuffer<Order>::remove(directory));
+}
+
+TEST_CASE("Journal Ring Buffer Replay", "[journal]") {
+    const auto directory = unique_directory("replay");
+    JournalRingBuffer<Order>::remove(directory);
+
+    auto journal = JournalRingBuffer<Order>::open(directory, small_segments());
+    for (std::uint64_t round = 0; round < 4; ++round) {
+        for (std::uint64_t i = 0; i < 10; ++i) {
+            REQUIRE(journal.try_push(Order{round * 10 + i, 0.0, 0}));
+        }
+        for (int i = 0; i < 10; ++i) {
+            REQUIRE(journal.try_pop().has_value());
+        }
+    }
+    REQUIRE(journal.try_push(Order{40, 0.0, 0}));  // Not consumed, so not replayed
+
+    std::vector<std::uint64_t> replayed;
+    const auto end = JournalRingBuffer<Order>::replay(directory, 3, [&](const Order& order) {
+        replayed.push_back(order.sequence);
+    });
+    REQUIRE(end == 40);
+    REQUIRE(replayed.size() == 37);
+    bool ordered = true;
+    for (std::size_t i = 0; i < replayed.size(); ++i) {
+        ordered = ordered && replayed[i] == i + 3;
+    }
+    REQUIRE(ordered);
+
+    REQUIRE(JournalRingBuffer<Order>::remove(directory));
+}
+
+TEST_CASE("Journal Ring Buffer SPSC Correctness", "[journal][threading]") {
+    const auto directory = unique_directory("spsc");
+    JournalRingBuffer<Order>::remove(directory);
+
+    constexpr std::uint64_t NUM_ITEMS = 100000;
+    JournalOptions options;
+    options.segment_entries = 4096;
+    options.capacity = 10000;
+    options.commit_every = 2048;
+    auto journal = JournalRingBuffer<Order>::open(directory, options);
+
+    std::thread producer([&]() {
+        for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+            while (!journal.try_push(Order{i, static_cast<double>(i), 0})) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint64_t received = 0;
+    bool in_order = true;
+    while (received < NUM_ITEMS) {
+        if (auto order = journal.try_pop()) {
+            in_order = in_order && order->sequence == received;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(journal.empty());
+    REQUIRE(journal.committed_head() == NUM_ITEMS - NUM_ITEMS % 2048);
+
+    REQUIRE(JournalRingBuffer<Order>::remove(directory));
+}
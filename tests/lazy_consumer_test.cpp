@@ -0,0 +1,140 @@
+/**
+ * @file lazy_consumer_test.cpp
+ * @brief Test suite for the batched-release consumer handle
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/dynamic_ring_buffer.hpp>
+#include <lockfree/lazy_consumer.hpp>
+#include <lockfree/ring_buffer.hpp>
+#include <lockfree/write_combining_producer.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+struct FullCapacityTraits : RingBufferTraits {
+    static constexpr bool kFreeRunningIndices = true;
+};
+
+} // namespace
+
+TEST_CASE("Lazy Consumer Thresholds", "[basic][lazyconsumer]") {
+    RingBuffer<int, 8> ring;  // Capacity of 7
+
+    SECTION("Slots are handed back once per batch") {
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE(ring.try_push(i));
+        }
+        LazyConsumer<RingBuffer<int, 8>> consumer(ring, 3);
+        REQUIRE(consumer.try_pop() == 0);
+        REQUIRE(consumer.try_pop() == 1);
+        REQUIRE(consumer.taken() == 2);
+        REQUIRE(ring.full());  // Producer cannot reuse the slots yet
+
+        REQUIRE(consumer.try_pop() == 2);
+        REQUIRE(consumer.taken() == 0);
+        REQUIRE(ring.size() == 4);
+        REQUIRE(ring.try_push(7));
+    }
+
+    SECTION("Seeing the ring empty hands back what was taken") {
+        REQUIRE(ring.try_push(1));
+        REQUIRE(ring.try_push(2));
+        LazyConsumer<RingBuffer<int, 8>> consumer(ring, 4);
+        REQUIRE(consumer.try_pop() == 1);
+        REQUIRE(consumer.try_pop() == 2);
+        REQUIRE(ring.size() == 2);
+
+        REQUIRE_FALSE(consumer.try_pop().has_value());
+        REQUIRE(consumer.taken() == 0);
+        REQUIRE(ring.empty());
+    }
+
+    SECTION("flush() and the destructor release a partial batch") {
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(ring.try_push(i));
+        }
+        {
+            LazyConsumer<RingBuffer<int, 8>> consumer(ring, 4);
+            REQUIRE(consumer.try_pop() == 0);
+            consumer.flush();
+            REQUIRE(ring.size() == 3);
+            REQUIRE(consumer.try_pop() == 1);
+            REQUIRE(ring.size() == 3);
+        }
+        REQUIRE(ring.size() == 2);
+        REQUIRE(ring.try_pop() == 2);
+    }
+
+    SECTION("Batch sizes outside [1, capacity] are rejected") {
+        using Consumer = LazyConsumer<RingBuffer<int, 8>>;
+        REQUIRE_THROWS_AS(Consumer(ring, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(Consumer(ring, 8), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Lazy Consumer Element Lifetime", "[basic][lazyconsumer][lifetime]") {
+    DynamicRingBuffer<std::shared_ptr<int>> ring(8);
+    auto tracked = std::make_shared<int>(42);
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(ring.try_push(tracked));
+    }
+    REQUIRE(tracked.use_count() == 6);
+
+    LazyConsumer<DynamicRingBuffer<std::shared_ptr<int>>> consumer(ring, 7);
+    for (int i = 0; i < 3; ++i) {
+        auto item = consumer.try_pop();
+        REQUIRE(item.has_value());
+        REQUIRE(**item == 42);
+    }
+    // Moved out, so the popped elements no longer hold a reference
+    REQUIRE(tracked.use_count() == 3);
+    consumer.flush();
+    REQUIRE(ring.size() == 2);
+    REQUIRE(tracked.use_count() == 3);
+}
+
+TEST_CASE("Lazy Consumer Correctness", "[spsc][lazyconsumer][threading]") {
+    constexpr int NUM_ITEMS = 200000;
+    RingBuffer<int, 1024, FullCapacityTraits> ring;
+    std::vector<int> received;
+    received.reserve(NUM_ITEMS);
+
+    // Batched on both sides: neither may stall on the other's unpublished index
+    std::thread producer_thread([&]() {
+        WriteCombiningProducer<RingBuffer<int, 1024, FullCapacityTraits>> producer(ring, 32);
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!producer.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer_thread([&]() {
+        LazyConsumer<RingBuffer<int, 1024, FullCapacityTraits>> consumer(ring, 32);
+        while (received.size() < static_cast<size_t>(NUM_ITEMS)) {
+            if (auto item = consumer.try_pop()) {
+                received.push_back(*item);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer_thread.join();
+    consumer_thread.join();
+
+    bool ordered = true;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        ordered = ordered && received[i] == i;
+    }
+    REQUIRE(ordered);
+    REQUIRE(ring.empty());
+}
@@ -0,0 +1,133 @@
+/**
+ * @file object_pool_ring_test.cpp
+ * @brief Test suite for the recycling object pool ring
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/object_pool_ring.hpp>
+
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+struct Packet {
+    std::uint64_t sequence = 0;
+    std::vector<char> payload;
+};
+
+} // namespace
+
+TEST_CASE("Object Pool Ring Basic Operations", "[basic][objectpool]") {
+    ObjectPoolRing<Packet, 8> packets([](Packet& p) { p.payload.reserve(256); });
+    REQUIRE(packets.pool_size() == 7);
+    REQUIRE(packets.available() == 7);
+    REQUIRE(packets.empty());
+
+    SECTION("Objects travel to the consumer and come back") {
+        Packet* sent = packets.try_acquire();
+        REQUIRE(sent != nullptr);
+        REQUIRE(packets.owns(sent));
+        sent->sequence = 1;
+        sent->payload.assign(100, 'a');
+        packets.publish(sent);
+        REQUIRE(packets.size() == 1);
+        REQUIRE(packets.available() == 6);
+
+        Packet* received = packets.try_receive();
+        REQUIRE(received == sent);
+        REQUIRE(received->sequence == 1);
+        REQUIRE(received->payload.size() == 100);
+        REQUIRE(packets.try_receive() == nullptr);
+        packets.recycle(received);
+        REQUIRE(packets.available() == 7);
+    }
+
+    SECTION("An exhausted pool pushes back on the producer") {
+        std::vector<Packet*> taken;
+        while (Packet* p = packets.try_acquire()) {
+            taken.push_back(p);
+        }
+        REQUIRE(taken.size() == 7);
+        REQUIRE_FALSE(packets.try_publish([](Packet&) {}));
+
+        for (Packet* p : taken) {
+            packets.publish(p);
+        }
+        REQUIRE(packets.size() == 7);
+        REQUIRE(packets.try_consume([](Packet&) {}));
+        REQUIRE(packets.try_acquire() == taken[0]);
+    }
+
+    SECTION("Recycled objects keep their buffers") {
+        std::set<const char*> buffers;
+        for (int round = 0; round < 50; ++round) {
+            REQUIRE(packets.try_publish([&](Packet& p) {
+                p.sequence = static_cast<std::uint64_t>(round);
+                p.payload.assign(200, static_cast<char>('a' + round % 26));
+            }));
+            REQUIRE(packets.try_consume([&](Packet& p) {
+                REQUIRE(p.sequence == static_cast<std::uint64_t>(round));
+                REQUIRE(p.payload.capacity() >= 256);
+                buffers.insert(p.payload.data());
+            }));
+        }
+        // Every buffer was reserved at construction and reused since
+        REQUIRE(buffers.size() <= packets.pool_size());
+    }
+
+    SECTION("Throwing callbacks do not leak objects") {
+        REQUIRE_THROWS_AS(packets.try_publish([](Packet&) { throw std::runtime_error("fill"); }),
+                          std::runtime_error);
+        REQUIRE(packets.empty());
+        REQUIRE(packets.try_publish([](Packet& p) { p.sequence = 9; }));
+        REQUIRE_THROWS_AS(packets.try_consume([](Packet&) { throw std::runtime_error("handle"); }),
+                          std::runtime_error);
+        REQUIRE(packets.available() == 7);
+
+        std::vector<Packet*> taken;
+        while (Packet* p = packets.try_acquire()) {
+            taken.push_back(p);
+        }
+        REQUIRE(taken.size() == 7);
+    }
+}
+
+TEST_CASE("Object Pool Ring SPSC Correctness", "[spsc][objectpool][threading]") {
+    constexpr std::uint64_t NUM_ITEMS = 100000;
+    ObjectPoolRing<Packet, 64> packets;
+
+    std::thread producer([&]() {
+        for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+            Packet* p = packets.acquire();
+            p->sequence = i;
+            p->payload.assign(static_cast<std::size_t>(i % 512), static_cast<char>(i));
+            packets.publish(p);
+        }
+    });
+
+    bool ordered = true;
+    bool intact = true;
+    std::set<const Packet*> seen;
+    for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+        Packet* p = packets.receive();
+        ordered = ordered && p->sequence == i;
+        intact = intact && p->payload.size() == i % 512 &&
+                 (p->payload.empty() || p->payload.back() == static_cast<char>(i));
+        seen.insert(p);
+        packets.recycle(p);
+    }
+    producer.join();
+
+    REQUIRE(ordered);
+    REQUIRE(intact);
+    REQUIRE(seen.size() <= packets.pool_size());
+    REQUIRE(packets.empty());
+    REQUIRE(packets.available() == packets.pool_size());
+}
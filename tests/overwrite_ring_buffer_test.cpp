@@ -0,0 +1,148 @@
+/**
+ * @file overwrite_ring_buffer_test.cpp
+ * @brief Test suite for the lossy overwrite-oldest ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/overwrite_ring_buffer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+using namespace lockfree;
+
+namespace {
+
+// Several words written together, so a torn read is detectable
+struct Snapshot {
+    std::uint64_t sequence;
+    std::uint64_t bid;
+    std::uint64_t ask;
+    std::uint64_t checksum;
+};
+
+Snapshot make_snapshot(std::uint64_t sequence) {
+    return {sequence, sequence * 3, sequence * 5, sequence * 9};
+}
+
+bool intact(const Snapshot& snapshot) {
+    return snapshot.bid == snapshot.sequence * 3 && snapshot.ask == snapshot.sequence * 5 &&
+           snapshot.checksum == snapshot.sequence * 9;
+}
+
+} // namespace
+
+TEST_CASE("Overwrite Ring Buffer Basic Operations", "[overwrite]") {
+    OverwriteRingBuffer<Snapshot, 8> ring;
+    REQUIRE(ring.capacity() == 8);
+    REQUIRE(ring.empty());
+    REQUIRE_FALSE(ring.try_pop().has_value());
+
+    SECTION("Behaves like a FIFO while the consumer keeps up") {
+        for (std::uint64_t i = 0; i < 8; ++i) {
+            ring.push(make_snapshot(i));
+        }
+        REQUIRE(ring.size() == 8);
+        for (std::uint64_t i = 0; i < 8; ++i) {
+            auto snapshot = ring.try_pop();
+            REQUIRE(snapshot.has_value());
+            REQUIRE(snapshot->sequence == i);
+            REQUIRE(intact(*snapshot));
+        }
+        REQUIRE_FALSE(ring.try_pop().has_value());
+        REQUIRE(ring.dropped() == 0);
+    }
+
+    SECTION("A lapped consumer skips to the newest element") {
+        for (std::uint64_t i = 0; i < 8; ++i) {
+            ring.push(make_snapshot(i));
+        }
+        REQUIRE(ring.try_pop()->sequence == 0);
+
+        // Seven unread elements plus ten more: the producer passes the consumer
+        for (std::uint64_t i = 8; i < 18; ++i) {
+            ring.push(make_snapshot(i));
+        }
+        REQUIRE(ring.size() == 8);
+
+        auto snapshot = ring.try_pop();
+        REQUIRE(snapshot.has_value());
+        REQUIRE(snapshot->sequence == 17);
+        REQUIRE(ring.dropped() == 16);
+        REQUIRE_FALSE(ring.try_pop().has_value());
+
+        // Back to normal once caught up
+        ring.emplace(make_snapshot(18));
+        REQUIRE(ring.pop().sequence == 18);
+        REQUIRE(ring.dropped() == 16);
+    }
+
+    SECTION("try_pop_latest discards older elements without counting them") {
+        for (std::uint64_t i = 0; i < 5; ++i) {
+            ring.push(make_snapshot(i));
+        }
+        auto latest = ring.try_pop_latest();
+        REQUIRE(latest.has_value());
+        REQUIRE(latest->sequence == 4);
+        REQUIRE(ring.empty());
+        REQUIRE(ring.dropped() == 0);
+        REQUIRE_FALSE(ring.try_pop_latest().has_value());
+    }
+
+    SECTION("A lapped try_pop_latest counts only the overwritten elements") {
+        for (std::uint64_t i = 0; i < 20; ++i) {
+            ring.push(make_snapshot(i));
+        }
+        auto latest = ring.try_pop_latest();
+        REQUIRE(latest.has_value());
+        REQUIRE(latest->sequence == 19);
+        REQUIRE(intact(*latest));
+        // Elements 0-11 were overwritten; 12-18 were still held and skipped on purpose
+        REQUIRE(ring.dropped() == 12);
+        REQUIRE(ring.empty());
+    }
+}
+
+TEST_CASE("Overwrite Ring Buffer Concurrent Slow Consumer", "[overwrite][threading]") {
+    constexpr std::uint64_t NUM_ITEMS = 500000;
+    auto ring = std::make_unique<OverwriteRingBuffer<Snapshot, 64>>();
+
+    std::atomic<bool> done{false};
+    std::uint64_t received = 0;
+    bool all_intact = true;
+    bool increasing = true;
+    std::thread consumer([&]() {
+        std::uint64_t next = 0;
+        while (true) {
+            const bool finished = done.load(std::memory_order_acquire);
+            auto snapshot = (received % 7 == 0) ? ring->try_pop_latest() : ring->try_pop();
+            if (!snapshot) {
+                if (finished) {
+                    break;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            all_intact = all_intact && intact(*snapshot);
+            increasing = increasing && snapshot->sequence >= next;
+            next = snapshot->sequence + 1;
+            ++received;
+        }
+    });
+
+    // The producer never waits, however far behind the consumer is
+    for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+        ring->push(make_snapshot(i));
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    REQUIRE(all_intact);
+    REQUIRE(increasing);
+    REQUIRE(received > 0);
+    REQUIRE(received + ring->dropped() <= NUM_ITEMS);
+    REQUIRE(ring->empty());
+}
@@ -0,0 +1,138 @@
+/**
+ * @file page_allocator_test.cpp
+ * @brief Test suite for huge-page and NUMA-aware ring storage placement
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/dynamic_ring_buffer.hpp>
+#include <lockfree/page_allocator.hpp>
+#include <lockfree/shared_ring_buffer.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace lockfree;
+
+namespace {
+
+// Huge pages may be unavailable and the test may run on any node, so every
+// placement here must work on a plain single-node machine.
+MemoryPlacement full_placement() {
+    MemoryPlacement placement;
+    placement.huge_pages = true;
+    placement.numa_node = current_numa_node();
+    placement.prefault = true;
+    placement.lock = true;
+    return placement;
+}
+
+// Number of pages of [data, data + size) currently resident
+std::size_t resident_pages(void* data, std::size_t size) {
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::string residency((size + page - 1) / page, '\0');
+    auto* vec = reinterpret_cast<unsigned char*>(&residency[0]);
+    if (::mincore(data, size, vec) != 0) {
+        return 0;
+    }
+    std::size_t count = 0;
+    for (auto flag : residency) {
+        count += static_cast<unsigned char>(flag) & 1U;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Page Allocator Allocation", "[placement]") {
+    const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+
+    SECTION("Default placement maps page-aligned storage") {
+        PageAllocator<std::uint64_t> allocator;
+        auto* data = allocator.allocate(1000);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(data) % page == 0);
+        for (std::uint64_t i = 0; i < 1000; ++i) {
+            data[i] = i;
+        }
+        REQUIRE(data[999] == 999);
+        allocator.deallocate(data, 1000);
+    }
+
+    SECTION("Prefaulted storage is resident before first use") {
+        MemoryPlacement placement;
+        placement.prefault = true;
+        PageAllocator<char> allocator(placement);
+        auto* data = allocator.allocate(16 * page);
+        REQUIRE(resident_pages(data, 16 * page) == 16);
+        allocator.deallocate(data, 16 * page);
+    }
+
+    SECTION("Huge-page requests are rounded and fall back when none are reserved") {
+        MemoryPlacement placement;
+        placement.huge_pages = true;
+        PageAllocator<char> allocator(placement);
+        auto* data = allocator.allocate(100);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(data) % page == 0);
+        data[0] = 'x';
+        data[99] = 'y';
+        allocator.deallocate(data, 100);
+    }
+
+    SECTION("Out-of-range NUMA nodes are rejected") {
+        MemoryPlacement placement;
+        placement.numa_node = -2;
+        PageAllocator<int> allocator(placement);
+        REQUIRE_THROWS_AS(allocator.allocate(16), std::invalid_argument);
+    }
+
+    SECTION("Rebound copies keep the placement and compare equal") {
+        MemoryPlacement placement;
+        placement.prefault = true;
+        PageAllocator<int> ints(placement);
+        PageAllocator<double> doubles(ints);
+        REQUIRE(doubles.placement().prefault);
+        REQUIRE(ints == doubles);
+        REQUIRE(ints != PageAllocator<int>());
+    }
+}
+
+TEST_CASE("Page Allocator Backs a Dynamic Ring Buffer", "[placement][dynamic]") {
+    PageAllocator<std::uint64_t> allocator(full_placement());
+    DynamicRingBuffer<std::uint64_t, PageAllocator<std::uint64_t>> buffer(4096, allocator);
+    REQUIRE(buffer.capacity() == 4095);
+
+    for (std::uint64_t lap = 0; lap < 3; ++lap) {
+        for (std::uint64_t i = 0; i < 4000; ++i) {
+            REQUIRE(buffer.try_push(lap * 4000 + i));
+        }
+        for (std::uint64_t i = 0; i < 4000; ++i) {
+            REQUIRE(buffer.try_pop() == lap * 4000 + i);
+        }
+    }
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("Shared Ring Buffer Placement", "[placement][shared]") {
+    const auto name = "/lockfree_test_" + std::to_string(::getpid()) + "_placement";
+    SharedRingBuffer<std::uint64_t>::remove(name);
+
+    auto producer = SharedRingBuffer<std::uint64_t>::create(name, 1024, full_placement());
+    MemoryPlacement attach_placement;
+    attach_placement.prefault = true;
+    auto consumer = SharedRingBuffer<std::uint64_t>::attach(name, attach_placement);
+
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(producer->try_push(i));
+    }
+    // A second attacher prefaulting the live ring must not disturb its contents
+    auto observer = SharedRingBuffer<std::uint64_t>::attach(name, attach_placement);
+    REQUIRE(observer->size() == 100);
+    for (std::uint64_t i = 0; i < 100; ++i) {
+        REQUIRE(consumer->try_pop() == i);
+    }
+    REQUIRE(consumer->empty());
+}
@@ -0,0 +1,156 @@
+/**
+ * @file pipeline_test.cpp
+ * @brief Test suite for the multi-stage pipeline builder
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/pipeline.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+TEST_CASE("Pipeline Transfers Through Typed Stages", "[pipeline][threading]") {
+    constexpr int NUM_ITEMS = 50000;
+    std::vector<std::string> published;
+    published.reserve(NUM_ITEMS);
+
+    auto pipeline = make_pipeline<int, 256>()
+                        .stage("square", [](int x) { return static_cast<long long>(x) * x; })
+                        .stage("format", [](long long x) { return std::to_string(x); })
+                        .sink("publish", [&](std::string s) { published.push_back(std::move(s)); });
+    REQUIRE(pipeline.stage_count() == 3);
+    pipeline.start();
+
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        REQUIRE(pipeline.push(i));
+    }
+    pipeline.drain();
+
+    REQUIRE(published.size() == static_cast<size_t>(NUM_ITEMS));
+    bool ordered = true;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        ordered = ordered && published[i] == std::to_string(static_cast<long long>(i) * i);
+    }
+    REQUIRE(ordered);
+
+    const auto stats = pipeline.stats();
+    REQUIRE(stats.size() == 3);
+    REQUIRE(stats[0].name == "square");
+    REQUIRE(stats[2].name == "publish");
+    for (const auto& stage : stats) {
+        REQUIRE(stage.processed == static_cast<std::uint64_t>(NUM_ITEMS));
+        REQUIRE(stage.input_size == 0);
+        REQUIRE(stage.input_capacity == 255);
+    }
+}
+
+TEST_CASE("Pipeline Move-Only Elements and Small Batches", "[pipeline][threading]") {
+    constexpr int NUM_ITEMS = 5000;
+    std::atomic<long long> total{0};
+    StageOptions unbatched;
+    unbatched.batch = 1;
+
+    {
+        auto pipeline = make_pipeline<std::unique_ptr<int>, 16>()
+                            .stage("unwrap", [](std::unique_ptr<int> p) { return *p; }, unbatched)
+                            .sink("sum", [&](int x) { total.fetch_add(x, std::memory_order_relaxed); });
+        pipeline.start();
+        for (int i = 1; i <= NUM_ITEMS; ++i) {
+            REQUIRE(pipeline.push(std::make_unique<int>(i)));
+        }
+        // The destructor drains as well
+    }
+    REQUIRE(total.load() == static_cast<long long>(NUM_ITEMS) * (NUM_ITEMS + 1) / 2);
+}
+
+TEST_CASE("Pipeline Backpressure Shows in Stats", "[pipeline][threading]") {
+    using namespace std::chrono_literals;
+    std::atomic<bool> release{false};
+    std::atomic<int> consumed{0};
+
+    auto pipeline = make_pipeline<int, 8>()
+                        .stage("fast", [](int x) { return x; })
+                        .sink("slow", [&](int) {
+                            while (!release.load()) {
+                                std::this_thread::sleep_for(100us);
+                            }
+                            ++consumed;
+                        });
+    pipeline.start();
+
+    // Both rings and the sink's current element fill up, then push() would block
+    int pushed = 0;
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (pipeline.try_push(pushed)) {
+            ++pushed;
+        } else if (pipeline.stats()[0].full_stalls > 0) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    const auto stats = pipeline.stats();
+    REQUIRE(stats[0].full_stalls > 0);
+    REQUIRE(stats[1].input_size <= stats[1].input_capacity);
+    REQUIRE(pushed <= 7 + 7 + 2);
+
+    release = true;
+    pipeline.drain();
+    REQUIRE(consumed.load() == pushed);
+}
+
+TEST_CASE("Pipeline Failure and Cancellation", "[pipeline][threading]") {
+    SECTION("A throwing stage cancels the pipeline and drain() rethrows") {
+        auto pipeline = make_pipeline<int, 64>()
+                            .stage("check", [](int x) {
+                                if (x == 100) {
+                                    throw std::runtime_error("bad element");
+                                }
+                                return x;
+                            })
+                            .sink("discard", [](int) {});
+        pipeline.start();
+
+        bool rejected = false;
+        for (int i = 0; i < 100000 && !rejected; ++i) {
+            rejected = !pipeline.push(i);
+        }
+        REQUIRE(rejected);
+        REQUIRE_THROWS_AS(pipeline.drain(), std::runtime_error);
+    }
+
+    SECTION("cancel() stops stages with elements still in flight") {
+        std::atomic<int> seen{0};
+        auto pipeline = make_pipeline<int, 64>()
+                            .sink("wait", [&](int) {
+                                ++seen;
+                                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                            });
+        pipeline.start();
+        for (int i = 0; i < 50; ++i) {
+            REQUIRE(pipeline.try_push(i));
+        }
+        pipeline.cancel();
+        REQUIRE(seen.load() < 50);
+    }
+
+    SECTION("Invalid options are rejected while building") {
+        StageOptions empty_batch;
+        empty_batch.batch = 0;
+        REQUIRE_THROWS_AS((make_pipeline<int, 64>().sink("sink", [](int) {}, empty_batch)), std::invalid_argument);
+
+        StageOptions bad_cpu;
+        bad_cpu.cpu = -5;
+        auto pipeline = make_pipeline<int, 64>().sink("sink", [](int) {}, bad_cpu);
+        REQUIRE_THROWS_AS(pipeline.start(), std::invalid_argument);
+    }
+}
@@ -5,6 +5,7 @@
  */
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
 #include <catch2/benchmark/catch_benchmark.hpp>
 #include <lockfree/ring_buffer.hpp>
 
@@ -15,6 +16,17 @@
 #include <chrono>
 #include <mutex>
 #include <queue>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
 
 using namespace lockfree;
 
@@ -79,6 +91,27 @@ TEST_CASE("Ring Buffer Basic Operations", "[basic]") {
         
         REQUIRE(buffer.empty());
     }
+
+    SECTION("Pop into an existing object") {
+        int out = -1;
+        REQUIRE_FALSE(buffer.try_pop(out));
+        REQUIRE(out == -1);  // Untouched when empty
+
+        REQUIRE(buffer.try_push(1));
+        REQUIRE(buffer.try_push(2));
+        REQUIRE(buffer.try_pop(out));
+        REQUIRE(out == 1);
+        REQUIRE(buffer.try_pop(out));
+        REQUIRE(out == 2);
+        REQUIRE(buffer.empty());
+
+        RingBuffer<std::string, 4> strings;
+        REQUIRE(strings.try_push(std::string(64, 'x')));
+        std::string text = "previous";
+        REQUIRE(strings.try_pop(text));
+        REQUIRE(text == std::string(64, 'x'));
+        REQUIRE(strings.empty());
+    }
 }
 
 TEST_CASE("Ring Buffer Move Semantics", "[move]") {
@@ -109,6 +142,97 @@ TEST_CASE("Ring Buffer Move Semantics", "[move]") {
     }
 }
 
+// Counts live instances so tests can check element lifetimes
+struct LifetimeTracker {
+    static inline int live = 0;
+    int value;
+
+    explicit LifetimeTracker(int v) : value(v) { ++live; }
+    LifetimeTracker(const LifetimeTracker& other) : value(other.value) { ++live; }
+    LifetimeTracker(LifetimeTracker&& other) noexcept : value(other.value) { ++live; }
+    LifetimeTracker& operator=(const LifetimeTracker&) = default;
+    LifetimeTracker& operator=(LifetimeTracker&&) = default;
+    ~LifetimeTracker() { --live; }
+};
+
+// Movable but not move-assignable and not default-constructible
+struct ConstructOnly {
+    const int value;
+    explicit ConstructOnly(int v) : value(v) {}
+    ConstructOnly(ConstructOnly&&) = default;
+    ConstructOnly& operator=(ConstructOnly&&) = delete;
+};
+
+TEST_CASE("Ring Buffer Element Lifetime", "[basic][lifetime]") {
+    LifetimeTracker::live = 0;
+
+    SECTION("Construction does not create elements") {
+        RingBuffer<LifetimeTracker, 1024> buffer;
+        REQUIRE(LifetimeTracker::live == 0);
+    }
+
+    SECTION("Pop destroys the slot") {
+        RingBuffer<LifetimeTracker, 8> buffer;
+        REQUIRE(buffer.try_emplace(1));
+        REQUIRE(buffer.try_push(LifetimeTracker(2)));
+        REQUIRE(LifetimeTracker::live == 2);
+
+        {
+            auto item = buffer.try_pop();
+            REQUIRE(item->value == 1);
+            REQUIRE(LifetimeTracker::live == 2);  // one in the buffer, one in item
+        }
+        REQUIRE(LifetimeTracker::live == 1);
+
+        REQUIRE(buffer.front()->value == 2);
+        buffer.pop_front();
+        REQUIRE(LifetimeTracker::live == 0);
+    }
+
+    SECTION("Destructor destroys queued elements") {
+        {
+            RingBuffer<LifetimeTracker, 8> buffer;
+            for (int i = 0; i < 5; ++i) {
+                REQUIRE(buffer.try_emplace(i));
+            }
+            (void)buffer.try_pop();
+            REQUIRE(LifetimeTracker::live == 4);
+        }
+        REQUIRE(LifetimeTracker::live == 0);
+    }
+
+    SECTION("Batch operations construct and destroy") {
+        RingBuffer<LifetimeTracker, 8> buffer;
+        std::vector<LifetimeTracker> input;
+        for (int i = 0; i < 6; ++i) {
+            input.emplace_back(i);
+        }
+
+        REQUIRE(buffer.try_push_n(input.data(), input.size()) == 6);
+        REQUIRE(LifetimeTracker::live == 12);
+
+        buffer.release(2);
+        REQUIRE(LifetimeTracker::live == 10);
+
+        std::vector<LifetimeTracker> output;
+        REQUIRE(buffer.try_pop_n(std::back_inserter(output), 8) == 4);
+        REQUIRE(output.front().value == 2);
+        REQUIRE(LifetimeTracker::live == 10);  // input + output, buffer empty
+    }
+
+    REQUIRE(LifetimeTracker::live == 0);
+
+    SECTION("Type without default constructor or move assignment") {
+        RingBuffer<ConstructOnly, 4> buffer;
+        REQUIRE(buffer.try_emplace(7));
+        REQUIRE(buffer.try_push(ConstructOnly(8)));
+
+        auto item = buffer.try_pop();
+        REQUIRE(item->value == 7);
+        REQUIRE(buffer.front()->value == 8);
+    }
+}
+
 TEST_CASE("Ring Buffer Wrap-Around", "[wraparound]") {
     RingBuffer<int, 8> buffer;  // Capacity of 7
     
@@ -136,6 +260,604 @@ TEST_CASE("Ring Buffer Wrap-Around", "[wraparound]") {
     }
 }
 
+struct UncachedTraits : RingBufferTraits {
+    static constexpr bool kCacheIndices = false;
+};
+
+TEST_CASE("Ring Buffer Index Caching", "[basic][cached]") {
+    SECTION("Uncached mode behaves identically") {
+        RingBuffer<int, 8, UncachedTraits> buffer;
+
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        REQUIRE(buffer.full());
+        REQUIRE_FALSE(buffer.try_push(999));
+
+        for (int i = 0; i < 7; ++i) {
+            auto item = buffer.try_pop();
+            REQUIRE(item.has_value());
+            REQUIRE(*item == i);
+        }
+        REQUIRE_FALSE(buffer.try_pop().has_value());
+    }
+
+    SECTION("Stale cache is refreshed on full and empty") {
+        RingBuffer<int, 4> buffer;  // Capacity of 3
+
+        // Alternate between full and empty so both caches go stale repeatedly
+        for (int cycle = 0; cycle < 50; ++cycle) {
+            for (int i = 0; i < 3; ++i) {
+                REQUIRE(buffer.try_push(cycle * 3 + i));
+            }
+            REQUIRE_FALSE(buffer.try_push(-1));
+
+            for (int i = 0; i < 3; ++i) {
+                auto item = buffer.try_pop();
+                REQUIRE(item.has_value());
+                REQUIRE(*item == cycle * 3 + i);
+            }
+            REQUIRE_FALSE(buffer.try_pop().has_value());
+        }
+    }
+}
+
+TEST_CASE("Ring Buffer Batch Operations", "[basic][batch]") {
+    SECTION("Push and pop a batch") {
+        RingBuffer<int, 16> buffer;
+        const int input[] = {1, 2, 3, 4, 5};
+
+        REQUIRE(buffer.try_push_n(input, 5) == 5);
+        REQUIRE(buffer.size() == 5);
+
+        int output[8] = {};
+        REQUIRE(buffer.try_pop_n(output, 8) == 5);
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(output[i] == input[i]);
+        }
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.try_pop_n(output, 8) == 0);
+    }
+
+    SECTION("Partial push when nearly full") {
+        RingBuffer<int, 8> buffer;  // Capacity of 7
+        std::vector<int> input(10);
+        for (int i = 0; i < 10; ++i) {
+            input[i] = i;
+        }
+
+        REQUIRE(buffer.try_push_n(input.data(), input.size()) == 7);
+        REQUIRE(buffer.full());
+        REQUIRE(buffer.try_push_n(input.data(), input.size()) == 0);
+
+        int output[3];
+        REQUIRE(buffer.try_pop_n(output, 3) == 3);
+        REQUIRE(output[2] == 2);
+        REQUIRE(buffer.try_push_n(input.data() + 7, 3) == 3);
+    }
+
+    SECTION("Batches across the wrap point") {
+        RingBuffer<int, 8> buffer;
+        int next_in = 0;
+        int next_out = 0;
+
+        for (int cycle = 0; cycle < 100; ++cycle) {
+            int input[5];
+            for (int& value : input) {
+                value = next_in++;
+            }
+            REQUIRE(buffer.try_push_n(input, 5) == 5);
+
+            int output[5];
+            REQUIRE(buffer.try_pop_n(output, 5) == 5);
+            for (int value : output) {
+                REQUIRE(value == next_out++);
+            }
+        }
+    }
+
+    SECTION("Iterator overloads with non-trivial type") {
+        RingBuffer<std::string, 8> buffer;
+        std::vector<std::string> input = {"alpha", "beta", "gamma"};
+
+        REQUIRE(buffer.try_push_n(input.begin(), input.end()) == 3);
+        REQUIRE(buffer.try_push_n(input.begin(), input.end()) == 3);
+
+        std::vector<std::string> output;
+        REQUIRE(buffer.try_pop_n(std::back_inserter(output), 10) == 6);
+        REQUIRE(output.size() == 6);
+        REQUIRE(output[0] == "alpha");
+        REQUIRE(output[5] == "gamma");
+    }
+
+    SECTION("Transform on pop across the wrap point") {
+        RingBuffer<int, 16> buffer;
+        int next_in = 0;
+        int next_out = 0;
+
+        for (int cycle = 0; cycle < 50; ++cycle) {
+            int input[11];
+            for (int& value : input) {
+                value = next_in++;
+            }
+            REQUIRE(buffer.try_push_n(input, 11) == 11);
+
+            double output[11];
+            REQUIRE(buffer.try_pop_n_transform(output, 11, [](int x) noexcept { return x * 0.5; }) == 11);
+            for (double value : output) {
+                REQUIRE(value == next_out++ * 0.5);
+            }
+        }
+        double output[4];
+        REQUIRE(buffer.try_pop_n_transform(output, 4, [](int x) noexcept { return x * 0.5; }) == 0);
+    }
+
+    SECTION("Transform on pop with non-trivial type and a throwing function") {
+        RingBuffer<std::string, 8> buffer;
+        for (const char* word : {"alpha", "beta", "gamma", "delta"}) {
+            REQUIRE(buffer.try_push(word));
+        }
+
+        std::vector<size_t> lengths;
+        REQUIRE(buffer.try_pop_n_transform(std::back_inserter(lengths), 2,
+                                           [](std::string s) { return s.size(); }) == 2);
+        REQUIRE(lengths == std::vector<size_t>{5, 4});
+
+        auto reject_delta = [](std::string s) {
+            if (s == "delta") {
+                throw std::runtime_error("rejected");
+            }
+            return s.size();
+        };
+        REQUIRE_THROWS_AS(buffer.try_pop_n_transform(std::back_inserter(lengths), 2, reject_delta),
+                          std::runtime_error);
+        REQUIRE(lengths == std::vector<size_t>{5, 4, 5});
+        REQUIRE(buffer.size() == 1);
+    }
+
+    SECTION("Streaming pops across the wrap point") {
+        RingBuffer<uint64_t, 1024> buffer;
+        std::vector<uint64_t> input(700);
+        std::vector<uint64_t> output(700);
+        uint64_t next_in = 0;
+        uint64_t next_out = 0;
+
+        for (int cycle = 0; cycle < 10; ++cycle) {
+            for (auto& value : input) {
+                value = next_in++;
+            }
+            REQUIRE(buffer.try_push_n(input.data(), input.size()) == input.size());
+
+            // Odd offset so the destination is not vector aligned
+            REQUIRE(buffer.try_pop_n_streaming(output.data() + 1, 699) == 699);
+            REQUIRE(buffer.try_pop_n_streaming(output.data(), 8) == 1);
+            bool ordered = output[0] == next_out + 699;
+            for (size_t i = 1; i < 700; ++i) {
+                ordered = ordered && output[i] == next_out + i - 1;
+            }
+            REQUIRE(ordered);
+            next_out += 700;
+        }
+        REQUIRE(buffer.try_pop_n_streaming(output.data(), 8) == 0);
+    }
+}
+
+// Fixed-size message used to check in-place access on large slots
+struct alignas(64) OrderMessage {
+    uint64_t sequence;
+    char payload[248];
+};
+
+TEST_CASE("Ring Buffer Zero-Copy Access", "[basic][zerocopy]") {
+    SECTION("Reserve, commit, peek and pop in place") {
+        RingBuffer<OrderMessage, 8> buffer;
+
+        REQUIRE(buffer.front() == nullptr);
+
+        OrderMessage* slot = buffer.try_reserve();
+        REQUIRE(slot != nullptr);
+        slot->sequence = 7;
+        std::memset(slot->payload, 'x', sizeof(slot->payload));
+
+        // Not visible until committed
+        REQUIRE(buffer.empty());
+        buffer.commit();
+        REQUIRE(buffer.size() == 1);
+
+        const OrderMessage* head = buffer.front();
+        REQUIRE(head != nullptr);
+        REQUIRE(head == slot);
+        REQUIRE(head->sequence == 7);
+        REQUIRE(head->payload[247] == 'x');
+
+        buffer.pop_front();
+        REQUIRE(buffer.empty());
+        REQUIRE(buffer.front() == nullptr);
+    }
+
+    SECTION("Reserve fails when full") {
+        RingBuffer<int, 4> buffer;  // Capacity of 3
+        for (int i = 0; i < 3; ++i) {
+            int* slot = buffer.try_reserve();
+            REQUIRE(slot != nullptr);
+            *slot = i;
+            buffer.commit();
+        }
+        REQUIRE(buffer.try_reserve() == nullptr);
+    }
+
+    SECTION("Region spans the wrap point") {
+        RingBuffer<int, 8> buffer;  // Capacity of 7
+
+        // Move the indices to 5 so the next region wraps
+        int scratch[5] = {};
+        REQUIRE(buffer.try_push_n(scratch, 5) == 5);
+        REQUIRE(buffer.try_pop_n(scratch, 5) == 5);
+
+        auto region = buffer.try_reserve_n(6);
+        REQUIRE(region.size() == 6);
+        REQUIRE(region.first.size == 3);
+        REQUIRE(region.second.size == 3);
+
+        int value = 0;
+        for (int& slot : region.first) {
+            slot = value++;
+        }
+        for (int& slot : region.second) {
+            slot = value++;
+        }
+        buffer.commit(region.size());
+
+        // Only one slot left
+        REQUIRE(buffer.try_reserve_n(6).size() == 1);
+
+        auto readable = buffer.read_span();
+        REQUIRE(readable.size() == 6);
+        REQUIRE(readable.first.size == 3);
+        int expected = 0;
+        for (int item : readable.first) {
+            REQUIRE(item == expected++);
+        }
+        for (int item : readable.second) {
+            REQUIRE(item == expected++);
+        }
+
+        buffer.release(4);
+        REQUIRE(buffer.size() == 2);
+        REQUIRE(*buffer.front() == 4);
+        buffer.release(2);
+        REQUIRE(buffer.read_span().empty());
+    }
+}
+
+struct FullCapacityTraits : RingBufferTraits {
+    static constexpr bool kFreeRunningIndices = true;
+};
+
+TEST_CASE("Ring Buffer Full-Capacity Mode", "[basic][fullcapacity]") {
+    RingBuffer<int, 8, FullCapacityTraits> buffer;
+
+    SECTION("Every slot is usable") {
+        REQUIRE(buffer.capacity() == 8);
+        REQUIRE(buffer.buffer_size() == 8);
+
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        REQUIRE(buffer.full());
+        REQUIRE(buffer.size() == 8);
+        REQUIRE_FALSE(buffer.try_push(999));
+        REQUIRE(buffer.try_reserve() == nullptr);
+
+        for (int i = 0; i < 8; ++i) {
+            auto item = buffer.try_pop();
+            REQUIRE(item.has_value());
+            REQUIRE(*item == i);
+        }
+        REQUIRE(buffer.empty());
+        REQUIRE_FALSE(buffer.try_pop().has_value());
+    }
+
+    SECTION("Wrap-around with batches and in-place access") {
+        int next_in = 0;
+        int next_out = 0;
+
+        for (int cycle = 0; cycle < 100; ++cycle) {
+            int input[8];
+            for (int& value : input) {
+                value = next_in++;
+            }
+            REQUIRE(buffer.try_push_n(input, 8) == 8);
+            REQUIRE(buffer.full());
+
+            auto readable = buffer.read_span();
+            REQUIRE(readable.size() == 8);
+            for (int item : readable.first) {
+                REQUIRE(item == next_out++);
+            }
+            for (int item : readable.second) {
+                REQUIRE(item == next_out++);
+            }
+            buffer.release(readable.size());
+
+            // Shift the indices so the next batch starts at a different slot
+            REQUIRE(buffer.try_push(next_in++));
+            REQUIRE(*buffer.front() == next_out++);
+            buffer.pop_front();
+        }
+    }
+}
+
+struct CountingTraits : RingBufferTraits {
+    using Stats = CountingStats;
+};
+
+TEST_CASE("Ring Buffer Stats", "[basic][stats]") {
+    SECTION("Disabled stats report zeros") {
+        RingBuffer<int, 8> buffer;
+        REQUIRE(buffer.try_push(1));
+        REQUIRE(buffer.try_pop().has_value());
+        const auto stats = buffer.stats();
+        REQUIRE(stats.pushed == 0);
+        REQUIRE(stats.popped == 0);
+    }
+
+    RingBuffer<int, 8, CountingTraits> buffer;
+
+    SECTION("Single operations and failures are counted") {
+        REQUIRE_FALSE(buffer.try_pop().has_value());
+        REQUIRE(buffer.front() == nullptr);
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        REQUIRE_FALSE(buffer.try_push(7));
+        REQUIRE(buffer.try_reserve() == nullptr);
+        REQUIRE(buffer.try_pop().has_value());
+        (void)buffer.pop();
+
+        const auto stats = buffer.stats();
+        REQUIRE(stats.pushed == 7);
+        REQUIRE(stats.push_full == 2);
+        REQUIRE(stats.popped == 2);
+        REQUIRE(stats.pop_empty == 2);
+        REQUIRE(stats.peak_occupancy == 7);
+        REQUIRE(stats.push_batches[0] == 7);
+        REQUIRE(stats.pop_batches[0] == 2);
+    }
+
+    SECTION("Batch sizes land in power-of-two buckets") {
+        const int values[] = {1, 2, 3, 4, 5};
+        REQUIRE(buffer.try_push_n(values, 5) == 5);
+        REQUIRE(buffer.try_push_n(values, 2) == 2);
+
+        int out[8];
+        REQUIRE(buffer.try_pop_n(out, 3) == 3);
+        const auto region = buffer.read_span();
+        buffer.release(region.size());
+
+        auto reserved = buffer.try_reserve_n(4);
+        for (auto& slot : reserved.first) {
+            slot = 0;
+        }
+        for (auto& slot : reserved.second) {
+            slot = 0;
+        }
+        buffer.commit(reserved.size());
+
+        const auto stats = buffer.stats();
+        REQUIRE(stats.pushed == 11);
+        REQUIRE(stats.popped == 7);
+        REQUIRE(stats.push_batches[2] == 2);  // 5 and 4
+        REQUIRE(stats.push_batches[1] == 1);  // 2
+        REQUIRE(stats.pop_batches[1] == 1);   // 3
+        REQUIRE(stats.pop_batches[2] == 1);   // 4
+        REQUIRE(stats.peak_occupancy == 7);
+    }
+}
+
+TEST_CASE("Ring Buffer Stats Concurrent Snapshot", "[stats][threading]") {
+    RingBuffer<int, 64, CountingTraits> buffer;
+    constexpr int NUM_ITEMS = 100000;
+
+    std::atomic<bool> done{false};
+    std::thread producer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            buffer.push(i);
+        }
+    });
+    std::thread consumer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            (void)buffer.pop();
+        }
+    });
+    // A monitoring thread may read the counters while both sides update them
+    bool monotonic = true;
+    std::thread monitor([&]() {
+        std::uint64_t last_pushed = 0;
+        while (!done.load(std::memory_order_acquire)) {
+            const auto stats = buffer.stats();
+            monotonic = monotonic && stats.pushed >= last_pushed;
+            last_pushed = stats.pushed;
+            std::this_thread::yield();
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    done.store(true, std::memory_order_release);
+    monitor.join();
+
+    const auto stats = buffer.stats();
+    REQUIRE(monotonic);
+    REQUIRE(stats.pushed == NUM_ITEMS);
+    REQUIRE(stats.popped == NUM_ITEMS);
+    REQUIRE(stats.peak_occupancy <= buffer.capacity());
+}
+
+struct PrefetchTraits : RingBufferTraits {
+    static constexpr std::size_t kPrefetchDistance = 4;
+};
+
+struct PrefetchFullCapacityTraits : PrefetchTraits {
+    static constexpr bool kFreeRunningIndices = true;
+};
+
+TEMPLATE_TEST_CASE("Ring Buffer Prefetch", "[basic][prefetch]", PrefetchTraits, PrefetchFullCapacityTraits) {
+    // Prefetching runs past the readable range and across the wrap point;
+    // results must be unaffected
+    SECTION("Single-element operations on large slots") {
+        RingBuffer<OrderMessage, 8, TestType> buffer;
+        for (uint64_t i = 0; i < 50; ++i) {
+            OrderMessage message{};
+            message.sequence = i;
+            REQUIRE(buffer.try_push(message));
+            REQUIRE(buffer.front()->sequence == i);
+            REQUIRE(buffer.try_pop()->sequence == i);
+        }
+    }
+
+    SECTION("Batch and zero-copy operations") {
+        RingBuffer<int, 16, TestType> buffer;
+        int next_in = 0;
+        int next_out = 0;
+        for (int round = 0; round < 20; ++round) {
+            int batch[11];
+            for (int& value : batch) {
+                value = next_in++;
+            }
+            REQUIRE(buffer.try_push_n(batch, 11) == 11);
+
+            auto region = buffer.try_reserve_n(3);
+            REQUIRE(region.size() == 3);
+            for (auto* segment : {&region.first, &region.second}) {
+                for (auto& slot : *segment) {
+                    slot = next_in++;
+                }
+            }
+            buffer.commit(3);
+
+            int out[7];
+            REQUIRE(buffer.try_pop_n(out, 7) == 7);
+            for (int value : out) {
+                REQUIRE(value == next_out++);
+            }
+            auto readable = buffer.read_span();
+            REQUIRE(readable.size() == 7);
+            REQUIRE(readable.first[0] == next_out);
+            next_out += 7;
+            buffer.release(7);
+        }
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("Non-trivial elements") {
+        RingBuffer<std::string, 8, TestType> buffer;
+        std::vector<std::string> input{"alpha", "beta", "gamma", "delta", "epsilon"};
+        for (int lap = 0; lap < 4; ++lap) {
+            REQUIRE(buffer.try_push_n(input.begin(), input.end()) == input.size());
+            std::vector<std::string> output;
+            REQUIRE(buffer.try_pop_n(std::back_inserter(output), 8) == input.size());
+            REQUIRE(output == input);
+        }
+    }
+}
+
+struct PaddedTraits : RingBufferTraits {
+    using Layout = PaddedLayout;
+};
+
+struct ScrambledTraits : RingBufferTraits {
+    using Layout = ScrambledLayout;
+};
+
+struct WideLineScrambledTraits : ScrambledTraits {
+    static constexpr std::size_t kCacheLineSize = 128;
+};
+
+TEST_CASE("Ring Buffer Slot Layout Policies", "[basic][layout]") {
+    SECTION("Padded slots fill whole lines") {
+        using Slots = PaddedLayout::Slots<int, 64>;
+        REQUIRE(sizeof(Slots::slot_type) == 64);
+        REQUIRE_FALSE(Slots::kContiguous);
+        // Elements that already fill lines are stored densely
+        REQUIRE(PaddedLayout::Slots<OrderMessage, 64>::kContiguous);
+    }
+
+    SECTION("Scrambling is a permutation that spreads neighbours over lines") {
+        using Slots = ScrambledLayout::Slots<int, 64>;
+        REQUIRE(Slots::kMinSlots == 256);
+        for (std::size_t capacity : {std::size_t{256}, std::size_t{1024}}) {
+            std::vector<bool> used(capacity, false);
+            for (std::size_t i = 0; i < capacity; ++i) {
+                const auto slot = Slots::slot_of(i, capacity - 1);
+                REQUIRE(slot < capacity);
+                REQUIRE_FALSE(used[slot]);
+                used[slot] = true;
+
+                const auto next = Slots::slot_of(i + 1, capacity - 1);
+                const auto gap = slot > next ? slot - next : next - slot;
+                REQUIRE(gap * sizeof(int) >= 64);
+            }
+        }
+        // Line-sized elements need no scrambling
+        REQUIRE(ScrambledLayout::Slots<OrderMessage, 64>::kContiguous);
+    }
+}
+
+TEMPLATE_TEST_CASE("Ring Buffer Slot Layouts", "[basic][layout]", PaddedTraits, ScrambledTraits,
+                   WideLineScrambledTraits) {
+    SECTION("FIFO order across several laps") {
+        RingBuffer<int, 1024, TestType> buffer;
+        int next_out = 0;
+        for (int i = 0; i < 3000; ++i) {
+            REQUIRE(buffer.try_push(i));
+            if (i % 3 == 0) {
+                REQUIRE(buffer.try_pop() == next_out++);
+            }
+            if (buffer.size() > 900) {
+                while (buffer.try_pop()) {
+                    ++next_out;
+                }
+            }
+        }
+        while (auto item = buffer.try_pop()) {
+            REQUIRE(*item == next_out++);
+        }
+        REQUIRE(next_out == 3000);
+    }
+
+    SECTION("Batches copy element by element") {
+        RingBuffer<int, 1024, TestType> buffer;
+        std::vector<int> input(700);
+        for (int lap = 0; lap < 4; ++lap) {
+            for (int i = 0; i < 700; ++i) {
+                input[i] = lap * 700 + i;
+            }
+            REQUIRE(buffer.try_push_n(input.data(), input.size()) == 700);
+            std::vector<int> output(700);
+            REQUIRE(buffer.try_pop_n(output.data(), output.size()) == 700);
+            REQUIRE(output == input);
+        }
+    }
+
+    SECTION("In-place access to single slots") {
+        RingBuffer<std::string, 1024, TestType> buffer;
+        for (int i = 0; i < 2000; ++i) {
+            auto* slot = buffer.try_reserve();
+            REQUIRE(slot != nullptr);
+            ::new (slot) std::string(std::to_string(i));
+            buffer.commit();
+            REQUIRE(*buffer.front() == std::to_string(i));
+            buffer.pop_front();
+        }
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("Indices follow the configured line size") {
+        REQUIRE(alignof(RingBuffer<int, 1024, TestType>) == TestType::kCacheLineSize);
+    }
+}
+
 TEST_CASE("SPSC Correctness", "[spsc][threading]") {
     RingBuffer<int, 1024> buffer;
     constexpr int NUM_ITEMS = 50000;
@@ -188,6 +910,263 @@ TEST_CASE("SPSC Correctness", "[spsc][threading]") {
     }
 }
 
+TEST_CASE("SPSC Batch Correctness", "[spsc][batch][threading]") {
+    RingBuffer<int, 256> buffer;
+    constexpr int NUM_ITEMS = 100000;
+    constexpr int BATCH_SIZE = 37;  // Deliberately not a divisor of the capacity
+
+    std::vector<int> received_items;
+    received_items.reserve(NUM_ITEMS);
+
+    std::thread producer([&]() {
+        int batch[BATCH_SIZE];
+        int next = 0;
+        while (next < NUM_ITEMS) {
+            const int count = std::min(BATCH_SIZE, NUM_ITEMS - next);
+            for (int i = 0; i < count; ++i) {
+                batch[i] = next + i;
+            }
+            int sent = 0;
+            while (sent < count) {
+                const auto pushed = buffer.try_push_n(batch + sent, count - sent);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                sent += static_cast<int>(pushed);
+            }
+            next += count;
+        }
+    });
+
+    std::thread consumer([&]() {
+        int batch[64];
+        while (received_items.size() < NUM_ITEMS) {
+            const auto popped = buffer.try_pop_n(batch, 64);
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+            received_items.insert(received_items.end(), batch, batch + popped);
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    REQUIRE(received_items.size() == NUM_ITEMS);
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        REQUIRE(received_items[i] == i);
+    }
+}
+
+TEST_CASE("SPSC Full-Capacity Correctness", "[spsc][fullcapacity][threading]") {
+    RingBuffer<int, 64, FullCapacityTraits> buffer;
+    constexpr int NUM_ITEMS = 50000;
+
+    std::vector<int> received_items;
+    received_items.reserve(NUM_ITEMS);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!buffer.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer([&]() {
+        while (received_items.size() < NUM_ITEMS) {
+            if (auto item = buffer.try_pop()) {
+                received_items.push_back(*item);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    REQUIRE(buffer.empty());
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        REQUIRE(received_items[i] == i);
+    }
+}
+
+template <typename Policy>
+struct WaitTraits : RingBufferTraits {
+    using WaitPolicy = Policy;
+};
+
+TEMPLATE_TEST_CASE("Blocking Push and Pop", "[blocking][threading]",
+                   BusySpinWait, PauseSpinWait, SpinYieldWait, SpinSleepWait) {
+    RingBuffer<int, 256, WaitTraits<TestType>> buffer;
+    constexpr int NUM_ITEMS = 20000;
+
+    std::vector<int> received_items;
+    received_items.reserve(NUM_ITEMS);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            buffer.push(i);
+        }
+    });
+
+    std::thread consumer([&]() {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            received_items.push_back(buffer.pop());
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    REQUIRE(buffer.empty());
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        REQUIRE(received_items[i] == i);
+    }
+}
+
+TEMPLATE_TEST_CASE("Blocking Timeouts", "[blocking]",
+                   BusySpinWait, PauseSpinWait, SpinYieldWait, SpinSleepWait) {
+    using namespace std::chrono_literals;
+    RingBuffer<std::string, 2, WaitTraits<TestType>> buffer;  // Capacity of 1
+
+    SECTION("Pop times out on empty buffer") {
+        const auto start = std::chrono::steady_clock::now();
+        REQUIRE_FALSE(buffer.try_pop_for(20ms).has_value());
+        REQUIRE(std::chrono::steady_clock::now() - start >= 20ms);
+    }
+
+    SECTION("Push times out on full buffer and keeps the item") {
+        REQUIRE(buffer.try_push_for(std::string("first"), 1ms));
+
+        std::string second = "second";
+        const auto deadline = std::chrono::steady_clock::now() + 20ms;
+        REQUIRE_FALSE(buffer.try_push_until(std::move(second), deadline));
+        REQUIRE(std::chrono::steady_clock::now() >= deadline);
+        REQUIRE(second == "second");  // Not moved from on failure
+
+        REQUIRE(*buffer.try_pop_for(1ms) == "first");
+    }
+
+    SECTION("Waiter is woken by the other side") {
+        std::thread producer([&]() {
+            std::this_thread::sleep_for(10ms);
+            buffer.push("late");
+        });
+
+        auto item = buffer.try_pop_for(5s);
+        producer.join();
+        REQUIRE(item.has_value());
+        REQUIRE(*item == "late");
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("Event FD Notification", "[blocking][eventfd]") {
+    using namespace std::chrono_literals;
+    using Traits = WaitTraits<EventFdWait>;
+
+    SECTION("Blocking calls sleep on the eventfd") {
+        RingBuffer<int, 256, Traits> buffer;
+        REQUIRE_FALSE(buffer.try_pop_for(20ms).has_value());
+
+        constexpr int NUM_ITEMS = 20000;
+        std::vector<int> received_items;
+        received_items.reserve(NUM_ITEMS);
+        std::thread producer([&]() {
+            for (int i = 0; i < NUM_ITEMS; ++i) {
+                buffer.push(i);
+            }
+        });
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            received_items.push_back(buffer.pop());
+        }
+        producer.join();
+
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            REQUIRE(received_items[i] == i);
+        }
+    }
+
+    SECTION("An armed consumer gets one signal per burst") {
+        RingBuffer<int, 256, Traits> buffer;
+        const int fd = buffer.notification_fd();
+        pollfd pfd{fd, POLLIN, 0};
+
+        // Pushes to a consumer that has not armed make no system call
+        REQUIRE(buffer.try_push(1));
+        REQUIRE(::poll(&pfd, 1, 0) == 0);
+        REQUIRE_FALSE(buffer.arm_notification());  // Data already readable
+        REQUIRE(buffer.try_pop() == 1);
+
+        REQUIRE(buffer.arm_notification());
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        std::uint64_t count = 0;
+        REQUIRE(::read(fd, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count)));
+        REQUIRE(count == 1);
+
+        buffer.clear_notification();  // Nothing pending
+        REQUIRE(::poll(&pfd, 1, 0) == 0);
+        REQUIRE(buffer.size() == 100);
+    }
+
+    SECTION("Consumer sleeps in epoll between bursts") {
+        constexpr int NUM_BURSTS = 20;
+        constexpr int BURST_SIZE = 50;
+        RingBuffer<int, 1024, Traits> buffer;
+
+        const int epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        REQUIRE(epoll_fd != -1);
+        epoll_event registration{};
+        registration.events = EPOLLIN;
+        registration.data.fd = buffer.notification_fd();
+        REQUIRE(::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, buffer.notification_fd(), &registration) == 0);
+
+        std::vector<int> received_items;
+        int wakeups = 0;
+        std::thread consumer([&]() {
+            while (true) {
+                while (auto item = buffer.try_pop()) {
+                    if (*item < 0) {
+                        return;
+                    }
+                    received_items.push_back(*item);
+                }
+                if (!buffer.arm_notification()) {
+                    continue;
+                }
+                epoll_event event{};
+                if (::epoll_wait(epoll_fd, &event, 1, -1) == 1) {
+                    ++wakeups;
+                    buffer.clear_notification();
+                }
+            }
+        });
+
+        int next = 0;
+        for (int burst = 0; burst < NUM_BURSTS; ++burst) {
+            for (int i = 0; i < BURST_SIZE; ++i) {
+                buffer.push(next++);
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        buffer.push(-1);
+        consumer.join();
+        ::close(epoll_fd);
+
+        REQUIRE(received_items.size() == static_cast<size_t>(NUM_BURSTS * BURST_SIZE));
+        for (int i = 0; i < NUM_BURSTS * BURST_SIZE; ++i) {
+            REQUIRE(received_items[i] == i);
+        }
+        // Woken per burst, not per message
+        REQUIRE(wakeups <= NUM_BURSTS * BURST_SIZE / 4);
+    }
+}
+#endif
+
 TEST_CASE("High Frequency Stress Test", "[stress][threading]") {
     RingBuffer<uint64_t, 2048> buffer;
     constexpr auto TEST_DURATION = std::chrono::milliseconds(500);  // Shorter for unit tests
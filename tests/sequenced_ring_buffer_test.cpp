@@ -0,0 +1,258 @@
+/**
+ * @file sequenced_ring_buffer_test.cpp
+ * @brief Test suite for the MPSC and SPMC ring buffers
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/sequenced_ring_buffer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+// Producer id in the high bits, per-producer sequence in the low bits
+constexpr std::uint64_t encode(std::uint64_t producer, std::uint64_t sequence) {
+    return (producer << 32) | sequence;
+}
+
+} // namespace
+
+TEST_CASE("MPSC Ring Buffer Basic Operations", "[mpsc]") {
+    MpscRingBuffer<int, 8> buffer;
+
+    SECTION("Every slot is usable") {
+        REQUIRE(buffer.capacity() == 8);
+        REQUIRE(buffer.empty());
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(buffer.try_push(i));
+        }
+        REQUIRE(buffer.full());
+        REQUIRE_FALSE(buffer.try_push(99));
+        REQUIRE(buffer.size() == 8);
+
+        for (int i = 0; i < 8; ++i) {
+            auto item = buffer.try_pop();
+            REQUIRE(item.has_value());
+            REQUIRE(*item == i);
+        }
+        REQUIRE_FALSE(buffer.try_pop().has_value());
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("Wrap around many times") {
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(buffer.try_push(i));
+            REQUIRE(buffer.try_push(i + 1000));
+            REQUIRE(*buffer.try_pop() == i);
+            REQUIRE(*buffer.try_pop() == i + 1000);
+        }
+        REQUIRE(buffer.empty());
+    }
+
+    SECTION("Batch operations") {
+        const int input[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        REQUIRE(buffer.try_push_n(input, 5) == 5);
+        REQUIRE(buffer.try_push_n(input + 5, 5) == 3);
+
+        int output[10] = {};
+        REQUIRE(buffer.try_pop_n(output, 6) == 6);
+        REQUIRE(buffer.try_pop_n(output + 6, 10) == 2);
+        REQUIRE(buffer.try_pop_n(output, 10) == 0);
+        for (int i = 0; i < 8; ++i) {
+            REQUIRE(output[i] == i);
+        }
+    }
+
+    SECTION("Blocking push and pop") {
+        buffer.push(1);
+        buffer.emplace(2);
+        REQUIRE(buffer.pop() == 1);
+        REQUIRE(buffer.pop() == 2);
+    }
+}
+
+TEST_CASE("SPMC Ring Buffer Basic Operations", "[spmc]") {
+    SpmcRingBuffer<int, 8> buffer;
+
+    for (int i = 0; i < 8; ++i) {
+        REQUIRE(buffer.try_push(i));
+    }
+    REQUIRE_FALSE(buffer.try_push(99));
+
+    int output[4] = {};
+    REQUIRE(buffer.try_pop_n(output, 4) == 4);
+    REQUIRE(output[0] == 0);
+    REQUIRE(output[3] == 3);
+    REQUIRE(buffer.pop() == 4);
+
+    const int more[4] = {8, 9, 10, 11};
+    REQUIRE(buffer.try_push_n(more, 4) == 4);
+    REQUIRE(buffer.size() == 7);
+    for (int expected = 5; expected < 12; ++expected) {
+        REQUIRE(*buffer.try_pop() == expected);
+    }
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("Sequenced Ring Buffer Element Lifetime", "[mpsc][spmc][lifetime]") {
+    const std::string long_text(64, 'x');  // heap-allocated, copy may throw
+
+    SECTION("MPSC accepts throwing copies by building the element first") {
+        MpscRingBuffer<std::string, 4> buffer;
+        REQUIRE(buffer.try_push(long_text));
+        buffer.push(long_text);
+        REQUIRE(buffer.try_emplace(3, 'y'));
+        REQUIRE(*buffer.try_pop() == long_text);
+        REQUIRE(buffer.pop() == long_text);
+        REQUIRE(*buffer.try_pop() == "yyy");
+    }
+
+    SECTION("Remaining elements are destroyed with the buffer") {
+        SpmcRingBuffer<std::string, 4> buffer;
+        REQUIRE(buffer.try_push(long_text));
+        REQUIRE(buffer.try_push(long_text));
+        // Leak checkers (ASan) verify the strings are released
+    }
+}
+
+TEST_CASE("MPSC Multi-Producer Correctness", "[mpsc][threading]") {
+    MpscRingBuffer<std::uint64_t, 1024> buffer;
+    constexpr std::uint64_t NUM_PRODUCERS = 4;
+    constexpr std::uint64_t ITEMS_PER_PRODUCER = 50000;
+
+    std::vector<std::thread> producers;
+    for (std::uint64_t p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([&buffer, p]() {
+            std::uint64_t i = 0;
+            while (i < ITEMS_PER_PRODUCER) {
+                // Mix the CAS, fetch_add and batch claim paths
+                if (i % 3 == 0) {
+                    buffer.push(encode(p, i));
+                    ++i;
+                } else if (i % 3 == 1) {
+                    if (buffer.try_push(encode(p, i))) {
+                        ++i;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                } else {
+                    const std::uint64_t batch[2] = {encode(p, i), encode(p, i + 1)};
+                    const auto count = std::min<std::uint64_t>(2, ITEMS_PER_PRODUCER - i);
+                    const auto pushed = buffer.try_push_n(batch, count);
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                    i += pushed;
+                }
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> next(NUM_PRODUCERS, 0);
+    bool in_order = true;
+    for (std::uint64_t received = 0; received < NUM_PRODUCERS * ITEMS_PER_PRODUCER; ++received) {
+        const auto value = buffer.pop();
+        const auto producer = value >> 32;
+        const auto sequence = value & 0xFFFFFFFFu;
+        if (producer >= NUM_PRODUCERS || sequence != next[producer]) {
+            in_order = false;
+            break;
+        }
+        ++next[producer];
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    REQUIRE(in_order);
+    for (std::uint64_t p = 0; p < NUM_PRODUCERS; ++p) {
+        REQUIRE(next[p] == ITEMS_PER_PRODUCER);
+    }
+    REQUIRE(buffer.empty());
+}
+
+TEST_CASE("SPMC Multi-Consumer Correctness", "[spmc][threading]") {
+    SpmcRingBuffer<std::uint64_t, 1024> buffer;
+    constexpr std::uint64_t NUM_CONSUMERS = 4;
+    constexpr std::uint64_t NUM_ITEMS = 200000;
+    constexpr std::uint64_t STOP = ~std::uint64_t{0};
+
+    std::vector<std::vector<std::uint64_t>> received(NUM_CONSUMERS);
+    std::vector<std::thread> consumers;
+    std::atomic<std::uint64_t> consumed{0};
+
+    SECTION("try_pop and try_pop_n claim with compare-exchange") {
+        for (std::uint64_t c = 0; c < NUM_CONSUMERS; ++c) {
+            consumers.emplace_back([&, c]() {
+                std::uint64_t batch[4];
+                while (consumed.load(std::memory_order_relaxed) < NUM_ITEMS) {
+                    std::size_t popped = 0;
+                    if (c % 2 == 0) {
+                        popped = buffer.try_pop_n(batch, 4);
+                    } else if (auto item = buffer.try_pop()) {
+                        batch[0] = *item;
+                        popped = 1;
+                    }
+                    if (popped == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    received[c].insert(received[c].end(), batch, batch + popped);
+                    consumed.fetch_add(popped, std::memory_order_relaxed);
+                }
+            });
+        }
+        for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+            buffer.push(i);
+        }
+    }
+
+    SECTION("pop claims with fetch_add") {
+        for (std::uint64_t c = 0; c < NUM_CONSUMERS; ++c) {
+            consumers.emplace_back([&, c]() {
+                for (auto item = buffer.pop(); item != STOP; item = buffer.pop()) {
+                    received[c].push_back(item);
+                }
+            });
+        }
+        for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+            while (!buffer.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+        for (std::uint64_t c = 0; c < NUM_CONSUMERS; ++c) {
+            buffer.push(STOP);
+        }
+    }
+
+    for (auto& consumer : consumers) {
+        consumer.join();
+    }
+
+    // Each consumer sees increasing values, and every value arrives exactly once
+    std::vector<std::uint64_t> all;
+    bool increasing = true;
+    for (const auto& items : received) {
+        increasing = increasing && std::is_sorted(items.begin(), items.end());
+        all.insert(all.end(), items.begin(), items.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    REQUIRE(increasing);
+    REQUIRE(all.size() == NUM_ITEMS);
+    bool exactly_once = true;
+    for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+        exactly_once = exactly_once && all[i] == i;
+    }
+    REQUIRE(exactly_once);
+    REQUIRE(buffer.empty());
+}
@@ -0,0 +1,198 @@
+/**
+ * @file shared_ring_buffer_test.cpp
+ * @brief Test suite for the cross-process shared memory ring buffer
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/shared_ring_buffer.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace lockfree;
+
+namespace {
+
+struct Tick {
+    std::uint64_t sequence;
+    double price;
+    std::uint32_t quantity;
+};
+
+// Unique per test process so parallel ctest runs do not collide
+std::string unique_name(const char* suffix) {
+    return "/lockfree_test_" + std::to_string(::getpid()) + "_" + suffix;
+}
+
+struct SharedFullCapacity : RingBufferTraits {
+    static constexpr bool kFreeRunningIndices = true;
+};
+
+struct SharedPadded : RingBufferTraits {
+    using Layout = PaddedLayout;
+};
+
+} // namespace
+
+TEST_CASE("Shared Ring Buffer Create and Attach", "[shared]") {
+    const auto name = unique_name("basic");
+    SharedRingBuffer<Tick>::remove(name);
+
+    SECTION("Attached handle sees the creator's elements") {
+        auto producer = SharedRingBuffer<Tick>::create(name, 64);
+        auto consumer = SharedRingBuffer<Tick>::attach(name);
+
+        REQUIRE(producer.is_owner());
+        REQUIRE_FALSE(consumer.is_owner());
+        REQUIRE(consumer->capacity() == 63);
+        REQUIRE(consumer->buffer_size() == 64);
+        REQUIRE(consumer->empty());
+
+        for (std::uint64_t i = 0; i < 63; ++i) {
+            REQUIRE(producer->try_push(Tick{i, 100.0 + i, 10}));
+        }
+        REQUIRE_FALSE(producer->try_push(Tick{}));
+        REQUIRE(consumer->full());
+
+        for (std::uint64_t i = 0; i < 63; ++i) {
+            auto tick = consumer->try_pop();
+            REQUIRE(tick.has_value());
+            REQUIRE(tick->sequence == i);
+            REQUIRE(tick->price == 100.0 + i);
+        }
+        REQUIRE_FALSE(consumer->try_pop().has_value());
+        REQUIRE(producer->empty());
+    }
+
+    SECTION("Creator removes the name on destruction") {
+        {
+            auto producer = SharedRingBuffer<Tick>::create(name, 64);
+        }
+        REQUIRE_THROWS_AS(SharedRingBuffer<Tick>::attach(name), std::system_error);
+    }
+
+    SECTION("Attached mapping outlives the creator") {
+        auto producer = SharedRingBuffer<Tick>::create(name, 16);
+        auto consumer = SharedRingBuffer<Tick>::attach(name);
+        REQUIRE(producer->try_push(Tick{7, 1.5, 1}));
+        producer = SharedRingBuffer<Tick>::create(unique_name("other"), 16);
+
+        auto tick = consumer->try_pop();
+        REQUIRE(tick.has_value());
+        REQUIRE(tick->sequence == 7);
+    }
+
+    SECTION("Full-capacity traits use every slot") {
+        auto producer = SharedRingBuffer<Tick, SharedFullCapacity>::create(name, 8);
+        auto consumer = SharedRingBuffer<Tick, SharedFullCapacity>::attach(name);
+        for (std::uint64_t i = 0; i < 8; ++i) {
+            REQUIRE(producer->try_push(Tick{i, 0.0, 0}));
+        }
+        REQUIRE_FALSE(producer->try_push(Tick{}));
+        REQUIRE(consumer->size() == 8);
+    }
+
+    SECTION("Padded layout places each slot on its own line") {
+        auto producer = SharedRingBuffer<Tick, SharedPadded>::create(name, 8);
+        auto consumer = SharedRingBuffer<Tick, SharedPadded>::attach(name);
+        for (std::uint64_t i = 0; i < 20; ++i) {
+            REQUIRE(producer->try_push(Tick{i, 0.0, 0}));
+            REQUIRE(consumer->try_pop()->sequence == i);
+        }
+        REQUIRE_THROWS_AS((SharedRingBuffer<Tick>::attach(name)), std::runtime_error);
+    }
+}
+
+TEST_CASE("Shared Ring Buffer Errors", "[shared]") {
+    const auto name = unique_name("errors");
+    SharedRingBuffer<Tick>::remove(name);
+
+    SECTION("Invalid sizes are rejected and leave no name behind") {
+        REQUIRE_THROWS_AS(SharedRingBuffer<Tick>::create(name, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(SharedRingBuffer<Tick>::create(name, 100), std::invalid_argument);
+        REQUIRE_FALSE(SharedRingBuffer<Tick>::remove(name));
+    }
+
+    SECTION("Creating an existing name fails") {
+        auto ring = SharedRingBuffer<Tick>::create(name, 64);
+        REQUIRE_THROWS_AS(SharedRingBuffer<Tick>::create(name, 64), std::system_error);
+    }
+
+    SECTION("Attaching to a missing name fails") {
+        REQUIRE_THROWS_AS(SharedRingBuffer<Tick>::attach(name), std::system_error);
+    }
+
+    SECTION("Attaching with a different element type fails") {
+        auto ring = SharedRingBuffer<Tick>::create(name, 64);
+        REQUIRE_THROWS_AS(SharedRingBuffer<std::uint64_t>::attach(name), std::runtime_error);
+    }
+
+    SECTION("Attaching with different traits fails") {
+        auto ring = SharedRingBuffer<Tick>::create(name, 64);
+        REQUIRE_THROWS_AS((SharedRingBuffer<Tick, SharedFullCapacity>::attach(name)), std::runtime_error);
+    }
+}
+
+TEST_CASE("Shared Ring Buffer File Backing", "[shared]") {
+    const std::string path = "/tmp/lockfree_test_" + std::to_string(::getpid()) + ".ring";
+    ::unlink(path.c_str());
+
+    auto producer = SharedRingBuffer<Tick>::create_file(path, 256);
+    auto consumer = SharedRingBuffer<Tick>::attach_file(path);
+    REQUIRE(producer->try_push(Tick{42, 2.0, 3}));
+    auto tick = consumer->try_pop();
+    REQUIRE(tick.has_value());
+    REQUIRE(tick->sequence == 42);
+}
+
+TEST_CASE("Shared Ring Buffer Cross-Process Transfer", "[shared][threading]") {
+    const auto name = unique_name("fork");
+    SharedRingBuffer<Tick>::remove(name);
+
+    constexpr std::uint64_t NUM_ITEMS = 100000;
+    auto consumer = SharedRingBuffer<Tick>::create(name, 1024);
+
+    const pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        // Producer process: no Catch2 assertions here, report via exit status
+        int status = 0;
+        try {
+            auto producer = SharedRingBuffer<Tick>::attach(name);
+            for (std::uint64_t i = 0; i < NUM_ITEMS; ++i) {
+                producer->push(Tick{i, static_cast<double>(i), static_cast<std::uint32_t>(i)});
+            }
+        } catch (...) {
+            status = 1;
+        }
+        ::_exit(status);
+    }
+
+    // Time out instead of hanging if the child failed to attach
+    std::uint64_t received = 0;
+    bool in_order = true;
+    while (received < NUM_ITEMS) {
+        auto tick = consumer->try_pop_for(std::chrono::seconds(10));
+        if (!tick) {
+            break;
+        }
+        in_order = in_order && tick->sequence == received &&
+                   tick->quantity == static_cast<std::uint32_t>(received);
+        ++received;
+    }
+
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    REQUIRE(received == NUM_ITEMS);
+    REQUIRE(in_order);
+    REQUIRE(consumer->empty());
+}
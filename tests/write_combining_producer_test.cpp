@@ -0,0 +1,192 @@
+/**
+ * @file write_combining_producer_test.cpp
+ * @brief Test suite for the batched-publish producer handle
+ * @author Fadli Arsani <fadlialim0029@gmail.com>
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <lockfree/dynamic_ring_buffer.hpp>
+#include <lockfree/ring_buffer.hpp>
+#include <lockfree/write_combining_producer.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lockfree;
+
+namespace {
+
+// Clock the test advances by hand
+struct ManualClock {
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<ManualClock>;
+    static constexpr bool is_steady = true;
+
+    static inline time_point current{};
+
+    static time_point now() noexcept {
+        return current;
+    }
+};
+
+struct ScrambledTraits : RingBufferTraits {
+    using Layout = ScrambledLayout;
+};
+
+} // namespace
+
+TEST_CASE("Write-Combining Producer Thresholds", "[basic][writecombining]") {
+    RingBuffer<int, 8> ring;  // Capacity of 7
+
+    SECTION("Elements stay invisible until a batch is staged") {
+        WriteCombiningProducer<RingBuffer<int, 8>> producer(ring, 4);
+        REQUIRE(producer.batch() == 4);
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(producer.try_push(i));
+        }
+        REQUIRE(producer.staged() == 3);
+        REQUIRE(ring.empty());
+
+        REQUIRE(producer.try_push(3));
+        REQUIRE(producer.staged() == 0);
+        REQUIRE(ring.size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(ring.try_pop() == i);
+        }
+    }
+
+    SECTION("flush() and the destructor publish a partial batch") {
+        {
+            WriteCombiningProducer<RingBuffer<int, 8>> producer(ring, 4);
+            REQUIRE(producer.try_push(1));
+            producer.flush();
+            REQUIRE(ring.size() == 1);
+            producer.flush();  // Nothing staged
+            REQUIRE(ring.size() == 1);
+            REQUIRE(producer.try_push(2));
+            REQUIRE(ring.size() == 1);
+        }
+        REQUIRE(ring.try_pop() == 1);
+        REQUIRE(ring.try_pop() == 2);
+        REQUIRE(ring.empty());
+    }
+
+    SECTION("A full ring publishes what is staged and rejects the push") {
+        WriteCombiningProducer<RingBuffer<int, 8>> producer(ring, 4);
+        for (int i = 0; i < 7; ++i) {
+            REQUIRE(producer.try_push(i));
+        }
+        REQUIRE(ring.size() == 4);
+        REQUIRE(producer.staged() == 3);
+
+        REQUIRE_FALSE(producer.try_push(7));
+        REQUIRE(producer.staged() == 0);
+        REQUIRE(ring.full());
+
+        REQUIRE(ring.try_pop() == 0);
+        REQUIRE(producer.try_push(7));
+        producer.flush();
+        for (int i = 1; i < 8; ++i) {
+            REQUIRE(ring.try_pop() == i);
+        }
+    }
+
+    SECTION("An old staged element forces a publish") {
+        using namespace std::chrono_literals;
+        WriteCombiningProducer<RingBuffer<int, 8>, ManualClock> producer(ring, 4, 10us);
+        REQUIRE(producer.try_push(1));
+        ManualClock::current += 5us;
+        REQUIRE(producer.try_push(2));
+        REQUIRE(ring.empty());
+
+        ManualClock::current += 5us;
+        REQUIRE(producer.try_push(3));
+        REQUIRE(ring.size() == 3);
+        REQUIRE(producer.staged() == 0);
+
+        // The clock restarts with the next staged element
+        REQUIRE(producer.try_push(4));
+        ManualClock::current += 9us;
+        REQUIRE(producer.try_push(5));
+        REQUIRE(ring.size() == 3);
+    }
+
+    SECTION("Batch sizes outside [1, capacity] are rejected") {
+        using Producer = WriteCombiningProducer<RingBuffer<int, 8>>;
+        REQUIRE_THROWS_AS(Producer(ring, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(Producer(ring, 8), std::invalid_argument);
+        Producer producer(ring, 7);
+        REQUIRE(producer.batch() == 7);
+    }
+}
+
+TEST_CASE("Write-Combining Producer Ring Types", "[basic][writecombining]") {
+    SECTION("Non-trivial elements in a dynamic ring") {
+        DynamicRingBuffer<std::string> ring(16);
+        {
+            WriteCombiningProducer<DynamicRingBuffer<std::string>> producer(ring, 5);
+            for (int i = 0; i < 12; ++i) {
+                REQUIRE(producer.try_emplace(32, static_cast<char>('a' + i)));
+            }
+            REQUIRE(ring.size() == 10);
+        }
+        for (int i = 0; i < 12; ++i) {
+            REQUIRE(ring.try_pop() == std::string(32, static_cast<char>('a' + i)));
+        }
+    }
+
+    SECTION("Scrambled slot layout") {
+        RingBuffer<int, 256, ScrambledTraits> ring;
+        WriteCombiningProducer<RingBuffer<int, 256, ScrambledTraits>> producer(ring, 16);
+        for (int lap = 0; lap < 4; ++lap) {
+            for (int i = 0; i < 200; ++i) {
+                REQUIRE(producer.try_push(lap * 200 + i));
+            }
+            producer.flush();
+            for (int i = 0; i < 200; ++i) {
+                REQUIRE(ring.try_pop() == lap * 200 + i);
+            }
+        }
+    }
+}
+
+TEST_CASE("Write-Combining Producer Correctness", "[spsc][writecombining][threading]") {
+    constexpr int NUM_ITEMS = 200000;
+    RingBuffer<int, 1024> ring;
+    std::vector<int> received;
+    received.reserve(NUM_ITEMS);
+
+    std::thread producer_thread([&]() {
+        WriteCombiningProducer<RingBuffer<int, 1024>> producer(ring, 32);
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!producer.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::thread consumer_thread([&]() {
+        while (received.size() < static_cast<size_t>(NUM_ITEMS)) {
+            if (auto item = ring.try_pop()) {
+                received.push_back(*item);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    producer_thread.join();
+    consumer_thread.join();
+
+    bool ordered = true;
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        ordered = ordered && received[i] == i;
+    }
+    REQUIRE(ordered);
+    REQUIRE(ring.empty());
+}